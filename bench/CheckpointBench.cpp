@@ -0,0 +1,65 @@
+/* CheckpointBench.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// a 60 Hz rollback loop: one checkpoint per frame kept in a 9 frame ring,
+// so the oldest one is 8 frames back when it is restored every 60th frame
+int main() {
+  using Clock = std::chrono::steady_clock;
+
+  constexpr std::size_t FRAMES = 600,
+                        RING   = 9,
+                        STATE  = 1024 * 1024;
+
+  noct::TapeVM vm;
+
+  auto  block = vm.alloc(STATE);
+  auto* bytes = reinterpret_cast<std::uint8_t*>(block);
+
+  std::memset(bytes, 0, STATE);
+
+  std::array<noct::TapeVM::Checkpoint, RING> ring;
+  Clock::duration                            saving { 0 },
+                                             restoring { 0 };
+  std::size_t                                restores = 0;
+
+  for (std::size_t frame = 0; frame < FRAMES; frame++) {
+    for (std::size_t i = 0; i < 16; i++) {
+      auto at = (frame * 4099 + i * 61) % STATE;
+
+      bytes[at]++;
+      vm.touch(block + at, 1ul);
+    }
+
+    vm.push(frame);
+
+    auto  start = Clock::now();
+    auto* base  = frame ? &ring[(frame - 1) % RING] : nullptr;
+
+    ring[frame % RING] = vm.checkpoint(base);
+    saving += Clock::now() - start;
+
+    if (frame >= RING && frame % 60 == 0) {
+      start = Clock::now();
+      vm.restore(ring[(frame + 1) % RING]);
+      restoring += Clock::now() - start;
+      restores++;
+    }
+  }
+
+  auto us = [](Clock::duration d, std::size_t n) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / 1000.0 / n;
+  };
+
+  std::cout << "checkpoint: " << us(saving, FRAMES) << " us/frame\n"
+            << "restore:    " << us(restoring, restores) << " us/rollback\n";
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+/* SandboxBench.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+
+#include <chrono>
+#include <iostream>
+
+// times @ and ! with raw and sandboxed access over a heap of many live
+// blocks: "blockwise" walks the cells of one block before moving on, the
+// way record code does, and "scattered" changes block on every access so
+// every check misses the last-hit cache
+int main() {
+  using Clock = std::chrono::steady_clock;
+
+  constexpr std::size_t BLOCKS = 512,
+                        CELLS  = 8,
+                        OPS    = 4096,
+                        ROUNDS = 200;
+
+  noct::TapeVM vm;
+  vm.loadTapeBase();
+
+  std::vector<std::uintptr_t> blocks;
+
+  for (std::size_t i = 0; i < BLOCKS; i++)
+    blocks.push_back(vm.alloc(CELLS * sizeof(std::uintptr_t)));
+
+  auto lit   = vm.findWord("(LIT)")->code[0].func;
+  auto fetch = vm.findWord("@")->code[0].func;
+  auto store = vm.findWord("!")->code[0].func;
+
+  noct::TapeVM::Word blockwise,
+                     scattered;
+
+  for (std::size_t i = 0; i < OPS; i++) {
+    auto cell = blocks[(i / CELLS) % BLOCKS] + (i % CELLS) * sizeof(std::uintptr_t);
+
+    blockwise.push_back({ lit, cell });
+    blockwise.push_back({ fetch, 0ul });
+    blockwise.push_back({ lit, cell });
+    blockwise.push_back({ store, 0ul });
+
+    scattered.push_back({ lit, blocks[(i * 7) % BLOCKS] });
+    scattered.push_back({ fetch, 0ul });
+    scattered.push_back({ lit, blocks[(i * 13) % BLOCKS] });
+    scattered.push_back({ store, 0ul });
+  }
+
+  for (const auto* word : { &blockwise, &scattered }) {
+    for (bool sandboxed : { false, true }) {
+      vm.setSandboxed(sandboxed);
+
+      auto start = Clock::now();
+
+      for (std::size_t round = 0; round < ROUNDS; round++) {
+        vm.xpush(*word);
+        vm.execute();
+      }
+
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+
+      std::cout << (word == &blockwise ? "blockwise " : "scattered ")
+                << (sandboxed ? "sandboxed: " : "raw:       ")
+                << double(ns) / (ROUNDS * OPS * 2) << " ns/access\n";
+    }
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+/* TapeBench.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// tape_bench [samples] [output.json]
+//
+// every workload runs on a fresh VM with a fixed setup and a fixed seed, is
+// warmed up once, then timed for the given number of samples; the report
+// carries min, median and p99 per workload so runs can be diffed across
+// commits
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  struct Workload {
+    std::string                        name;
+    std::function<void(noct::TapeVM&)> setup;
+    std::string                        sample;
+  };
+
+  struct Result {
+    std::string name;
+    double      min,
+                median,
+                p99;
+  };
+
+  std::filesystem::path moduleDirectory() {
+    auto dir = std::filesystem::temp_directory_path() / "tape_bench";
+    std::filesystem::create_directories(dir);
+    return dir;
+  }
+
+  // a module of many small definitions, each calling the one before it
+  void writeModule(const std::filesystem::path& path, std::size_t words) {
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+
+    out << ": m0 #0 ;\n";
+
+    for (std::size_t i = 1; i < words; i++)
+      out << ": m" << i << " m" << (i - 1) << " #" << i << " + ; ( n -- n )\n";
+  }
+
+  std::vector<Workload> workloads() {
+    std::vector<Workload> list;
+
+    list.push_back({ "do-loop-sum", [](noct::TapeVM& vm){
+      vm.evaluate(": sum #0 #1000000 #0 DO I + LOOP ;");
+    }, "sum drop" });
+
+    list.push_back({ "fib", [](noct::TapeVM& vm){
+      vm.evaluate(": fib dup #2 < IF EXIT THEN dup #1 - fib swap #2 - fib + ;");
+    }, "#22 fib drop" });
+
+    list.push_back({ "sieve", [](noct::TapeVM& vm){
+      vm.evaluate(
+        "#65536 CONSTANT n "
+        "n ALLOC CONSTANT flags "
+        ": sieve flags n #1 FILL #0 n #2 DO "
+        "  flags I + c@ IF #1 + "
+        "    I dup * n < IF n I dup * DO #0 flags I + c! J +LOOP THEN "
+        "  THEN "
+        "LOOP ;"
+      );
+    }, "sieve drop" });
+
+    // thousands of words in the dictionary, looked up in a shuffled order
+    {
+      constexpr std::size_t WORDS = 4096;
+
+      std::vector<std::size_t> order(WORDS);
+      std::ostringstream       lookups;
+      std::mt19937             rng(1u);
+
+      for (std::size_t i = 0; i < WORDS; i++)
+        order[i] = i;
+
+      std::shuffle(order.begin(), order.end(), rng);
+
+      for (auto i : order)
+        lookups << "w" << i << " drop ";
+
+      list.push_back({ "dictionary-lookup", [](noct::TapeVM& vm){
+        std::ostringstream defs;
+
+        for (std::size_t i = 0; i < WORDS; i++)
+          defs << ": w" << i << " #" << i << " ;\n";
+
+        vm.evaluate(defs.str());
+      }, lookups.str() });
+    }
+
+    {
+      std::ostringstream def;
+
+      def << ": lits";
+
+      for (std::size_t i = 0; i < 4096; i++)
+        def << " #" << i;
+
+      def << " ;";
+
+      list.push_back({ "literal-compile", [](noct::TapeVM&){}, def.str() });
+    }
+
+    list.push_back({ "include-module", [](noct::TapeVM& vm){
+      auto dir = moduleDirectory();
+      writeModule(dir / "benchmod.tape", 2048);
+      vm.addIncludeDirectory((dir / "?.tape").string());
+    }, "INCLUDE benchmod" });
+
+    list.push_back({ "string-capture", [](noct::TapeVM& vm){
+      vm.evaluate(": cap >STR #256 #0 DO I . LOOP STR> ;");
+    }, "cap drop drop" });
+
+    list.push_back({ "alloc-churn", [](noct::TapeVM& vm){
+      vm.evaluate(": churn #4096 #0 DO I #15 & #1 + #16 * ALLOC free LOOP ;");
+    }, "churn" });
+
+    return list;
+  }
+
+  Result run(const Workload& workload, std::size_t samples) {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+    workload.setup(vm);
+
+    std::vector<double> times;
+    times.reserve(samples);
+
+    vm.evaluate(workload.sample);
+
+    for (std::size_t i = 0; i < samples; i++) {
+      auto start = Clock::now();
+      vm.evaluate(workload.sample);
+      times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+      vm.resetScratchArena(noct::TapeVM::ScratchReset::Line);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    auto rank = [&](double q) {
+      return times[std::min(times.size() - 1, static_cast<std::size_t>(q * (times.size() - 1) + 0.5))];
+    };
+
+    return { workload.name, times.front(), rank(0.5), rank(0.99) };
+  }
+}
+
+int main(int argc, char** argv) {
+  std::size_t   samples = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 50ul;
+  std::ofstream file;
+
+  if (!samples)
+    samples = 1;
+
+  if (argc > 2)
+    file.open(argv[2], std::ios::out | std::ios::trunc);
+
+  std::ostream& out = file.is_open() ? file : std::cout;
+
+  out << "{\n  \"samples\": " << samples << ",\n  \"unit\": \"us\",\n  \"results\": [";
+
+  bool first = true;
+
+  for (const auto& workload : workloads()) {
+    try {
+      auto result = run(workload, samples);
+
+      out << (first ? "\n" : ",\n")
+          << "    { \"name\": \"" << result.name << "\""
+          << ", \"min\": "        << result.min
+          << ", \"median\": "     << result.median
+          << ", \"p99\": "        << result.p99 << " }";
+
+      first = false;
+    }
+    catch (noct::Error& e) {
+      std::cerr << workload.name << ": " << e.what() << "\n";
+      return 1;
+    }
+  }
+
+  out << "\n  ]\n}\n";
+  return 0;
+}
\ No newline at end of file
@@ -29,6 +29,12 @@
 #endif
 
 
+// guard page backed tape stacks rely on mmap and SIGSEGV
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS) && !defined(__NoctSys_UNIX__)
+  #undef NOCTSYS_TAPE_GUARDED_STACKS
+#endif
+
+
 
 #if defined(__NoctSys_Windows__)
   #define __NoctSys_Export__ __declspec(dllexport)
@@ -8,6 +8,8 @@
 #include <NoctSys/Configuration.hxx>
 #include <NoctSys/Utilities.hpp>
 #include <NoctSys/Resource/NativeScript.hpp>
+#include <NoctSys/Resource/HandleTable.hpp>
+#include <NoctSys/Resource/SnapshotTable.hpp>
 
 // XML Library
 #include <pugixml.hpp>
@@ -21,15 +23,30 @@
 #include <SFML/System/String.hpp>
 
 // Standard Library
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 #define NSRESDB_VERSION 1.1
 
 namespace noct {
+  // how long a replaced NativeScript outlives its last holder, for raw
+  // function pointers taken from it during the current frame
+  constexpr std::chrono::milliseconds NATIVE_SCRIPT_GRACE { 2000 };
+
+  class ResourcePack;
 
 #if defined(__NoctSys_UNIX__)
   typedef unsigned long ColorInt;
@@ -52,6 +69,13 @@ namespace noct {
   typedef std::shared_ptr<NativeScript>    NativeScriptPtr;
   typedef std::optional<sf::Color>         MaybeColor;
 
+  typedef ResourceHandle<TexturePtr>      TextureHandle;
+  typedef ResourceHandle<FontPtr>         FontHandle;
+  typedef ResourceHandle<SoundBufferPtr>  SoundHandle;
+  typedef ResourceHandle<ShaderPtr>       ShaderHandle;
+  typedef ResourceHandle<ColorInt>        ColorHandle;
+  typedef ResourceHandle<NativeScriptPtr> NativeScriptHandle;
+
   typedef Resource<TexturePtr>     TextureResource;
   typedef Resource<FontPtr>        FontResource;
   typedef Resource<SoundBufferPtr> SoundResource;
@@ -68,6 +92,55 @@ namespace noct {
   };
 
 
+  // what a database file lists, before anything is loaded
+  class NoctSysAPI ManifestEntry
+  {
+  public:
+    enum Type
+      : std::uint8_t
+    {
+      Texture,
+      Font,
+      Sound,
+      Shader,
+      Script
+    };
+
+    Type                  type;
+    std::string           name;
+    std::filesystem::path path;
+    sf::Shader::Type      shaderType { sf::Shader::Type::Fragment };
+    bool                  isInline   { false };
+    std::string           code;
+
+    // set when the bytes are already in memory, as with a pack mapping
+    const std::uint8_t*   data       { nullptr };
+    std::size_t           size       { 0ul };
+  };
+
+  class NoctSysAPI ResourceManifest
+  {
+  public:
+    std::filesystem::path                         textureDirectory,
+                                                  fontDirectory,
+                                                  soundDirectory,
+                                                  shaderDirectory,
+                                                  scriptDirectory;
+    std::vector<ManifestEntry>                    entries;
+    std::vector<std::pair<std::string, ColorInt>> colors;
+  };
+
+
+  // Lazy only registers what the manifest lists; each entry is decoded on
+  // first find or by prefetch
+  enum class LoadMode
+    : std::uint8_t
+  {
+    Eager,
+    Lazy
+  };
+
+
   typedef std::map<sf::String, TextureResource> TextureMap;
   typedef std::map<sf::String, FontResource>    FontMap;
   typedef std::map<sf::String, SoundResource>   SoundMap;
@@ -77,6 +150,28 @@ namespace noct {
 
   class NoctSysAPI ResourceDatabase
   {
+    // batch names the deferred load started for the entry, 0 before one is
+    struct PendingEntry {
+      ManifestEntry            entry;
+      std::shared_future<void> load;
+      std::uint64_t            batch;
+    };
+
+    typedef std::pair<ManifestEntry::Type, sf::String> PendingKey;
+
+    // what a budgeted entry costs and how to load it again once evicted
+    struct Usage {
+      ManifestEntry                               entry;
+      std::size_t                                 bytes;
+      std::weak_ptr<const void>                   data;
+      std::shared_ptr<std::atomic<std::uint64_t>> used;
+    };
+
+    struct RetiredScript {
+      NativeScriptPtr                       script;
+      std::chrono::steady_clock::time_point since;
+    };
+
     mutable std::mutex    m_mutex;
 
     std::filesystem::path m_textureDirectory,
@@ -91,11 +186,48 @@ namespace noct {
     ShaderMap             m_shaders;
     ColorMap              m_colors;
     NativeScriptMap       m_nativeScripts;
+    std::vector<RetiredScript>
+                          m_retiredScripts;
+    std::map<PendingKey, PendingEntry>
+                          m_pending;
+    std::uint64_t         m_batches;
+    std::vector<std::shared_ptr<ResourcePack>>
+                          m_packs;
+    std::map<PendingKey, Usage>
+                          m_usage;
+    std::array<std::size_t, 5>
+                          m_budgets;
+    std::atomic<std::uint64_t>
+                          m_tick;
+
+    // handle tables kept in step with the maps above; find* and handle
+    // lookups read the published copies without the lock
+    HandleTable<TexturePtr>      m_textureHandles;
+    HandleTable<FontPtr>         m_fontHandles;
+    HandleTable<SoundBufferPtr>  m_soundHandles;
+    HandleTable<ShaderPtr>       m_shaderHandles;
+    HandleTable<ColorInt>        m_colorHandles;
+    HandleTable<NativeScriptPtr> m_scriptHandles;
+
+    SnapshotTable<HandleTable<TexturePtr>>      m_textureView;
+    SnapshotTable<HandleTable<FontPtr>>         m_fontView;
+    SnapshotTable<HandleTable<SoundBufferPtr>>  m_soundView;
+    SnapshotTable<HandleTable<ShaderPtr>>       m_shaderView;
+    SnapshotTable<HandleTable<ColorInt>>        m_colorView;
+    SnapshotTable<HandleTable<NativeScriptPtr>> m_scriptView;
+
+    std::mutex            m_loaderMutex;
+    std::condition_variable
+                          m_loaderWake;
+    std::deque<std::packaged_task<bool()>>
+                          m_loaderJobs;
+    std::thread           m_loader;
+    bool                  m_loaderStop;
 
   public:
     
     ResourceDatabase();
-    ResourceDatabase(const std::filesystem::path& xml_path);
+    ResourceDatabase(const std::filesystem::path& xml_path, LoadMode mode=LoadMode::Eager);
     ~ResourceDatabase();
 
     void setTextureDirectory(const std::filesystem::path& directory);
@@ -104,15 +236,49 @@ namespace noct {
     void setShaderDirectory(const std::filesystem::path& directory);
     void setScriptDirectory(const std::filesystem::path& directory);
     
-    void loadFromFile(const std::filesystem::path& xml_path);
+    void loadFromFile(const std::filesystem::path& xml_path, LoadMode mode=LoadMode::Eager);
+    void loadFromPack(const std::filesystem::path& pack_path, LoadMode mode=LoadMode::Eager);
     bool saveToFile(const std::filesystem::path& xml_path);
 
+    // parses and checks a database file without loading anything
+    static ResourceManifest readManifest(const std::filesystem::path& xml_path);
+
+    // reads the compiled <xml>.nmc beside the file while it still matches,
+    // otherwise parses the XML and rewrites the cache
+    static ResourceManifest readCachedManifest(const std::filesystem::path& xml_path);
+
     bool loadTextureFromFile(const std::filesystem::path& path, const std::string_view& name={});
     bool loadFontFromFile(const std::filesystem::path& path, const std::string_view& name={});
     bool loadSoundFromFile(const std::filesystem::path& path, const std::string_view& name={});
     bool loadShaderFromFile(const std::filesystem::path& path, sf::Shader::Type type, const std::string_view&name={});
     bool loadNativeScriptFromFile(const std::filesystem::path& path, const std::string_view& name={});
 
+    // dlopen and symbol resolution run on the loader thread; the script is
+    // only swapped in once it is fully resolved
+    std::future<bool> loadNativeScriptAsync(const std::filesystem::path& path, const std::string_view& name={});
+
+    // a replaced or erased script is closed once nothing holds it and
+    // NATIVE_SCRIPT_GRACE has passed. Swaps and erases close whatever has
+    // expired by then, but the last one retired waits for the next of
+    // them; hosts call this periodically, say once a frame beside
+    // trimResources, so it is not kept open indefinitely
+    void              collectNativeScripts();
+
+    // decodes the named pending entries of any type together, in parallel;
+    // entries another thread is already loading are waited on
+    void prefetch(const StringVector& names);
+
+    // decoded bytes a type may hold before its least recently used entries
+    // with no outside owners are evicted, zero for no limit; only textures,
+    // fonts and sounds have budgets. An evicted entry reloads on its next
+    // find, and entries used since the last trim are never evicted
+    void        setBudget(ManifestEntry::Type type, std::size_t bytes);
+    std::size_t getBudget(ManifestEntry::Type type);
+    std::size_t getUsage(ManifestEntry::Type type);
+
+    // advances the use clock and evicts what is over budget, once a frame
+    void trimResources();
+
     void addColor(const std::string_view& name, const sf::Color& color);
     void addColor(const sf::Color& color, const std::string_view& name);
 
@@ -123,6 +289,21 @@ namespace noct {
     MaybeColor      findColor(const std::string_view& name);
     NativeScriptPtr findNativeScript(const std::string_view& name);
 
+    // resolve once, then look up by slot; a stale handle finds nothing
+    TextureHandle      resolveTexture(const std::string_view& name);
+    FontHandle         resolveFont(const std::string_view& name);
+    SoundHandle        resolveSound(const std::string_view& name);
+    ShaderHandle       resolveShader(const std::string_view& name);
+    ColorHandle        resolveColor(const std::string_view& name);
+    NativeScriptHandle resolveNativeScript(const std::string_view& name);
+
+    TexturePtr      findTexture(TextureHandle handle);
+    FontPtr         findFont(FontHandle handle);
+    SoundBufferPtr  findSound(SoundHandle handle);
+    ShaderPtr       findShader(ShaderHandle handle);
+    MaybeColor      findColor(ColorHandle handle);
+    NativeScriptPtr findNativeScript(NativeScriptHandle handle);
+
     bool eraseTexture(const std::string_view& name);
     bool eraseFont(const std::string_view& name);
     bool eraseSound(const std::string_view& name);
@@ -145,14 +326,31 @@ namespace noct {
     void writeColorDatabase(std::fstream& file);
     void writeScriptDatabase(std::fstream& file);
 
-    void readTextureDatabase(pugi::xml_node& root);
-    void readFontDatabase(pugi::xml_node& root);
-    void readSoundDatabase(pugi::xml_node& root);
-    void readShaderDatabase(pugi::xml_node& root);
-    void readColorDatabase(pugi::xml_node& root);
-    void readScriptDatabase(pugi::xml_node& root);
+    static void readManifest(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readTextureDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readFontDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readSoundDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readShaderDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readColorDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    static void readScriptDatabase(pugi::xml_node& root, ResourceManifest& manifest);
+    void loadManifest(const ResourceManifest& manifest, std::uint64_t batch=0ul);
+    void registerManifest(const ResourceManifest& manifest);
+
+    std::shared_future<void> startPending(const std::vector<PendingKey>& keys);
+    bool                     awaitPending(std::unique_lock<std::mutex>& lock, ManifestEntry::Type type, const sf::String& name);
+    void                     listPending(ManifestEntry::Type type, StringVector& list);
+
+    template<typename Map, typename T>
+    void publish(const Map& map, HandleTable<T>& handles, SnapshotTable<HandleTable<T>>& view);
+
+    void recordUsage(const ManifestEntry& entry, std::size_t bytes, const std::shared_ptr<const void>& data);
+    void enforceBudgets();
+
+    void                         swapNativeScript(const sf::String& name, const NativeScriptPtr& script);
+    std::vector<NativeScriptPtr> expireNativeScripts();
+    void                         runLoader();
 
-    std::string      shaderTypeToString(sf::Shader::Type type);
-    sf::Shader::Type shaderTypeFromString(const std::string& type);
+    static std::string      shaderTypeToString(sf::Shader::Type type);
+    static sf::Shader::Type shaderTypeFromString(const std::string& type);
   };
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+/* HandleTable.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace noct {
+  // a slot index and the generation it was issued at; a slot's generation
+  // moves on when its entry is erased, which leaves old handles stale
+  template<typename T>
+  struct ResourceHandle {
+    static constexpr std::uint32_t NONE = ~std::uint32_t(0);
+
+    std::uint32_t index      { NONE },
+                  generation { 0u };
+
+    explicit operator bool() const {
+      return index != NONE;
+    }
+
+    bool operator==(const ResourceHandle& other) const {
+      return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const ResourceHandle& other) const {
+      return !(*this == other);
+    }
+  };
+
+
+  // dense slots plus a hashed name index. A name keeps its slot when it is
+  // reassigned, so handles follow reloads. Names and use stamps live in
+  // shared buffers, so the index's string_view keys stay valid and a stamp
+  // written through one copy of the table is seen by all of them
+  template<typename T>
+  class HandleTable
+  {
+    struct Slot {
+      std::shared_ptr<const std::string>          name;
+      T                                           data;
+      std::uint32_t                               generation;
+      std::shared_ptr<std::atomic<std::uint64_t>> used;
+    };
+
+    static const T* stamp(const Slot& slot, std::uint64_t tick) {
+      if (slot.used->load(std::memory_order_relaxed) != tick)
+        slot.used->store(tick, std::memory_order_relaxed);
+
+      return &slot.data;
+    }
+
+    std::vector<Slot>                                   m_slots;
+    std::unordered_map<std::string_view, std::uint32_t> m_names;
+    std::vector<std::uint32_t>                          m_free;
+
+  public:
+    ResourceHandle<T> resolve(std::string_view name) const {
+      auto it = m_names.find(name);
+
+      if (it == m_names.end())
+        return {};
+
+      return { it->second, m_slots[it->second].generation };
+    }
+
+    // nullptr for a null or stale handle
+    const T* get(ResourceHandle<T> handle) const {
+      if (handle.index >= m_slots.size())
+        return nullptr;
+
+      const auto& slot = m_slots[handle.index];
+
+      if (!slot.name || slot.generation != handle.generation)
+        return nullptr;
+
+      return &slot.data;
+    }
+
+    const T* find(std::string_view name) const {
+      auto it = m_names.find(name);
+      return it != m_names.end() ? &m_slots[it->second].data : nullptr;
+    }
+
+    // get and find that also mark the entry as used at tick
+    const T* use(ResourceHandle<T> handle, std::uint64_t tick) const {
+      return get(handle) ? stamp(m_slots[handle.index], tick) : nullptr;
+    }
+
+    const T* use(std::string_view name, std::uint64_t tick) const {
+      auto it = m_names.find(name);
+      return it != m_names.end() ? stamp(m_slots[it->second], tick) : nullptr;
+    }
+
+    std::shared_ptr<std::atomic<std::uint64_t>> usage(std::string_view name) const {
+      auto it = m_names.find(name);
+      return it != m_names.end() ? m_slots[it->second].used : nullptr;
+    }
+
+    // empty for a null or stale handle
+    std::string nameOf(ResourceHandle<T> handle) const {
+      return get(handle) ? *m_slots[handle.index].name : std::string();
+    }
+
+    ResourceHandle<T> assign(const std::string& name, T data) {
+      auto it = m_names.find(name);
+
+      if (it != m_names.end()) {
+        m_slots[it->second].data = std::move(data);
+        return { it->second, m_slots[it->second].generation };
+      }
+
+      std::uint32_t index;
+
+      if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+      }
+      else {
+        index = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.push_back({ nullptr, T(), 0u, nullptr });
+      }
+
+      auto& slot = m_slots[index];
+
+      slot.name = std::make_shared<const std::string>(name);
+      slot.data = std::move(data);
+      slot.used = std::make_shared<std::atomic<std::uint64_t>>(0ul);
+      m_names.emplace(*slot.name, index);
+
+      return { index, slot.generation };
+    }
+
+    bool erase(std::string_view name) {
+      auto it = m_names.find(name);
+
+      if (it == m_names.end())
+        return false;
+
+      auto& slot = m_slots[it->second];
+
+      m_free.push_back(it->second);
+      m_names.erase(it);
+
+      slot.name.reset();
+      slot.used.reset();
+      slot.data = T();
+      slot.generation++;
+
+      return true;
+    }
+
+    std::vector<std::string> names() const {
+      std::vector<std::string> list;
+
+      for (const auto& entry : m_names)
+        list.emplace_back(entry.first);
+
+      return list;
+    }
+  };
+}
\ No newline at end of file
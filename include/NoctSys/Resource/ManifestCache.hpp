@@ -0,0 +1,108 @@
+/* ManifestCache.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Resource/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+/* The compiled form of a database XML, kept beside it as <xml>.nmc, native
+ * endian:
+ *
+ *   ManifestCacheHeader
+ *   ManifestColor[colors]
+ *   ManifestRecord[count]   paths already joined with their directory
+ *   strings                 not terminated
+ *
+ * It is only trusted while the XML's mtime, size and FNV-1a hash all match
+ * the ones it was written with. Everything is read in place from the
+ * mapping; only manifest() copies, since the database owns what it loads.
+ */
+
+namespace noct {
+  constexpr std::uint32_t MANIFEST_CACHE_VERSION = 1;
+
+  struct ManifestStamp {
+    std::uint64_t mtime,
+                  size,
+                  hash;
+  };
+
+  struct ManifestString {
+    std::uint32_t offset,
+                  length;
+  };
+
+  struct ManifestCacheHeader {
+    char           magic[4];
+    std::uint32_t  version,
+                   count,
+                   colors;
+    ManifestStamp  stamp;
+    std::uint64_t  stringsOffset,
+                   stringsSize;
+    ManifestString directories[5];
+  };
+
+  struct ManifestColor {
+    ManifestString name;
+    std::uint64_t  value;
+  };
+
+  struct ManifestRecord {
+    ManifestString name,
+                   path,
+                   code;
+    std::uint8_t   type,
+                   shaderType,
+                   isInline,
+                   reserved;
+  };
+
+  static_assert(sizeof(ManifestCacheHeader) == 96, "ManifestCacheHeader must be 96 bytes");
+  static_assert(sizeof(ManifestColor) == 16, "ManifestColor must be 16 bytes");
+  static_assert(sizeof(ManifestRecord) == 28, "ManifestRecord must be 28 bytes");
+
+
+  class NoctSysAPI ManifestCache
+  {
+    MappedFile                 m_file;
+    const ManifestCacheHeader* m_header;
+    const ManifestColor*       m_colors;
+    const ManifestRecord*      m_records;
+    const char*                m_strings;
+
+  public:
+    ManifestCache();
+
+    ManifestCache(const ManifestCache&)            = delete;
+    ManifestCache& operator=(const ManifestCache&) = delete;
+
+    static std::filesystem::path pathFor(const std::filesystem::path& xml_path);
+    static bool                  stamp(const std::filesystem::path& xml_path, ManifestStamp& out);
+    static bool                  write(const std::filesystem::path& cache_path, const ManifestStamp& stamp,
+                                       const ResourceManifest& manifest, std::string& error);
+
+    // false if the cache is missing, corrupt or stale against the XML; the
+    // XML is only hashed once its mtime and size already match
+    bool open(const std::filesystem::path& cache_path, const std::filesystem::path& xml_path);
+    void close();
+    bool isOpen() const;
+
+    std::size_t           count() const;
+    const ManifestRecord* records() const;
+    std::size_t           colorCount() const;
+    const ManifestColor*  colors() const;
+    std::string_view      string(ManifestString str) const;
+
+    ResourceManifest manifest() const;
+  };
+}
\ No newline at end of file
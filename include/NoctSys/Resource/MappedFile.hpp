@@ -0,0 +1,46 @@
+/* MappedFile.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace noct {
+  class NoctSysAPI MappedFile
+  {
+    std::filesystem::path m_path;
+    std::uint8_t*         m_data;
+    std::size_t           m_size;
+    std::string           m_error;
+    bool                  m_open,
+                          m_copyOnWrite;
+
+#if defined(__NoctSys_Windows__)
+    void*                 m_file;
+    void*                 m_mapping;
+#endif
+
+  public:
+    MappedFile();
+    explicit MappedFile(const std::filesystem::path& path, bool copyOnWrite=false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool                         open(const std::filesystem::path& path, bool copyOnWrite=false);
+    void                         close();
+    bool                         isOpen() const;
+    const std::uint8_t*          data() const;
+    std::uint8_t*                mutableData();
+    std::size_t                  size() const;
+    const std::string&           getError() const;
+    const std::filesystem::path& getFilePath() const;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+/* NativePlugin.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <cstdint>
+
+#define NOCT_PLUGIN_ABI 2
+
+#define NOCT_PLUGIN_ENTRY "noct_plugin_entry"
+
+#define NOCT_PLUGIN_EXPORT extern "C" __NoctSys_Export__
+
+#define NOCT_PLUGIN_ID(a, b, c, d) \
+  ((std::uint32_t(std::uint8_t(a)) << 24) | (std::uint32_t(std::uint8_t(b)) << 16) | \
+   (std::uint32_t(std::uint8_t(c)) << 8)  |  std::uint32_t(std::uint8_t(d)))
+
+// a plugin module exports one entry point,
+//
+//   NOCT_PLUGIN_EXPORT const NoctPluginHeader* noct_plugin_entry(std::uint32_t abi);
+//
+// returning a static table that starts with a NoctPluginHeader and is
+// followed by the interface's function pointers. An interface is a struct
+// with the header as its first member, an ID naming it and a VERSION
+// constant; the table's id is set to that ID. It may only grow by
+// appending, so size and version both only go up:
+//
+//   struct AudioPlugin {
+//     static constexpr std::uint32_t ID      = NOCT_PLUGIN_ID('A', 'U', 'D', 'I');
+//     static constexpr std::uint32_t VERSION = 2;
+//
+//     NoctPluginHeader header;
+//     void           (*mix)(float* out, std::size_t frames);
+//     void           (*stop)();
+//   };
+extern "C" {
+  enum NoctPluginFlags
+    : std::uint32_t
+  {
+    NOCT_PLUGIN_RELOADABLE = 1u << 0,
+    NOCT_PLUGIN_THREADSAFE = 1u << 1
+  };
+
+  struct NoctPluginHeader {
+    std::uint32_t abi,
+                  id,
+                  size,
+                  version,
+                  flags;
+    const char*   name;
+  };
+
+  typedef const NoctPluginHeader* (*NoctPluginEntry)(std::uint32_t abi);
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <NoctSys/Configuration.hxx>
+#include <NoctSys/Resource/NativePlugin.hpp>
 #include <filesystem>
 
 #define NATIVESCRIPT_VERSION_MAJOR 1
@@ -35,6 +36,7 @@ namespace noct {
   {
     const std::filesystem::path m_path;
     ModuleHandle                m_handle;
+    const NoctPluginHeader*     m_plugin;
 
 #if defined(__NoctSys_UNIX__)
     std::string                 m_error;
@@ -45,6 +47,8 @@ namespace noct {
 
 #endif
 
+    bool                        loadPlugin();
+
   public:
     NativeScript();
     NativeScript(const std::filesystem::path& path);
@@ -57,11 +61,26 @@ namespace noct {
     const std::filesystem::path& getFilePath();
     LoaderHandle                 find(const std::string_view& symbol);
 
+    bool                         isPlugin();
+    const NoctPluginHeader*      getPluginHeader();
+    bool                         hasCapability(std::uint32_t flags);
+
+    // the module's table as interface T, or nullptr when the module has no
+    // plugin entry, implements another interface, or its table is older or
+    // smaller than T
+    template<typename PluginT>
+    const PluginT* plugin() {
+      if (m_plugin && m_plugin->id == PluginT::ID && m_plugin->size >= sizeof(PluginT) && m_plugin->version >= PluginT::VERSION)
+        return reinterpret_cast<const PluginT*>(m_plugin);
+
+      return nullptr;
+    }
+
     template<typename LoaderT>
     LoaderT findAs(const std::string_view& symbol) {
       LoaderHandle loader = find(symbol);
 
-      if (m_error == 0)
+      if (loader)
         return reinterpret_cast<LoaderT>(loader);
       
       return {};
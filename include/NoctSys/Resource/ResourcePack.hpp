@@ -0,0 +1,114 @@
+/* ResourcePack.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Resource/MappedFile.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* A pack is one file holding what a database manifest points at, native
+ * endian:
+ *
+ *   PackHeader
+ *   PackEntry[buckets]   open addressed on hash(type, name), linear probing,
+ *                        empty buckets have a zero nameLength
+ *   strings              entry names and source paths, not terminated
+ *   blobs                each at a RESOURCE_PACK_ALIGNMENT boundary
+ *
+ * Textures, fonts, sounds and shaders are packed; native scripts have to be
+ * dlopen'd from a file, so they and colours stay in the XML.
+ */
+
+namespace noct {
+  constexpr std::uint32_t RESOURCE_PACK_VERSION   = 1;
+  constexpr std::size_t   RESOURCE_PACK_ALIGNMENT = 64;
+
+  // PackEntry::flags; an inline shader's blob is its source
+  constexpr std::uint8_t  PACK_ENTRY_INLINE       = 0x01;
+
+  struct PackHeader {
+    char          magic[4];
+    std::uint32_t version,
+                  count,
+                  buckets;
+    std::uint64_t stringsOffset,
+                  stringsSize;
+  };
+
+  struct PackEntry {
+    std::uint64_t hash,
+                  offset,
+                  size;
+    std::uint32_t name,
+                  nameLength,
+                  path,
+                  pathLength;
+    std::uint8_t  type,
+                  shaderType,
+                  flags;
+    std::uint8_t  reserved[5];
+  };
+
+  static_assert(sizeof(PackHeader) == 32, "PackHeader must be 32 bytes");
+  static_assert(sizeof(PackEntry) == 48, "PackEntry must be 48 bytes");
+
+
+  class NoctSysAPI ResourcePack
+  {
+    MappedFile         m_file;
+    const PackHeader*  m_header;
+    const PackEntry*   m_entries;
+    const char*        m_strings;
+    std::string        m_error;
+
+  public:
+    ResourcePack();
+    explicit ResourcePack(const std::filesystem::path& path);
+
+    ResourcePack(const ResourcePack&)            = delete;
+    ResourcePack& operator=(const ResourcePack&) = delete;
+
+    static std::uint64_t hash(ManifestEntry::Type type, std::string_view name);
+
+    bool open(const std::filesystem::path& path);
+    void close();
+    bool isOpen() const;
+
+    const PackEntry*    find(ManifestEntry::Type type, std::string_view name) const;
+    const std::uint8_t* data(const PackEntry& entry) const;
+    std::string_view    name(const PackEntry& entry) const;
+    std::string_view    path(const PackEntry& entry) const;
+    std::size_t         count() const;
+
+    // every entry, pointing into the mapping; the pack has to outlive
+    // whatever is loaded from it
+    ResourceManifest manifest() const;
+
+    const std::string&           getError() const;
+    const std::filesystem::path& getFilePath() const;
+  };
+
+
+  class NoctSysAPI ResourcePackWriter
+  {
+    std::vector<ManifestEntry> m_entries;
+
+  public:
+    // reads nothing yet; a non-inline entry's file is streamed in by write
+    void add(const ManifestEntry& entry);
+    void add(const ResourceManifest& manifest);
+
+    std::size_t count() const;
+
+    bool write(const std::filesystem::path& path, std::string& error) const;
+  };
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+/* SnapshotTable.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace noct {
+  // an immutable copy of a table behind an atomic pointer. Readers never
+  // lock: they mark themselves in the current epoch's counter, use the
+  // snapshot and leave. Writers, serialised by their own lock, swap in a
+  // new snapshot and flip the epoch twice, waiting each time for the
+  // readers of the old parity to drain, before freeing the old one
+  template<typename T>
+  class SnapshotTable
+  {
+    std::atomic<const T*>      m_current;
+    std::atomic<std::uint64_t> m_epoch;
+    mutable std::atomic<std::uint64_t>
+                               m_readers[2];
+
+  public:
+    SnapshotTable()
+      : m_current(new T()), m_epoch(0ul), m_readers{ {0ul}, {0ul} }
+    {}
+
+    SnapshotTable(const SnapshotTable&) = delete;
+    SnapshotTable& operator=(const SnapshotTable&) = delete;
+
+    ~SnapshotTable() {
+      delete m_current.load();
+    }
+
+    // f must copy out what it needs; the snapshot is gone once read returns
+    template<typename F>
+    auto read(F&& f) const {
+      struct Section {
+        std::atomic<std::uint64_t>& count;
+        ~Section() { count.fetch_sub(1ul); }
+      } section { m_readers[m_epoch.load() & 1ul] };
+
+      section.count.fetch_add(1ul);
+      return f(*m_current.load());
+    }
+
+    void publish(T next) {
+      const T* old = m_current.exchange(new T(std::move(next)));
+
+      for (auto i = 0; i < 2; i++) {
+        auto epoch = m_epoch.fetch_add(1ul);
+
+        while (m_readers[epoch & 1ul].load() != 0ul)
+          std::this_thread::yield();
+      }
+
+      delete old;
+    }
+  };
+}
\ No newline at end of file
@@ -7,6 +7,11 @@
 #include <NoctSys/Configuration.hxx>
 #include <NoctSys/Scripting/TapeVM/InputStream.hpp>
 #include <NoctSys/Scripting/TapeVM/OutputStream.hpp>
+#include <NoctSys/Scripting/TapeVM/IncludeIndex.hpp>
+#include <NoctSys/Scripting/TapeVM/GuardedStack.hpp>
+#include <NoctSys/Scripting/TapeVM/RegionIndex.hpp>
+#include <NoctSys/Scripting/TapeVM/TraceRing.hpp>
+#include <NoctSys/Resource/MappedFile.hpp>
 
 #include <cstdint>
 #include <atomic>
@@ -15,6 +20,10 @@
 #include <mutex>
 #include <vector>
 #include <map>
+#include <set>
+#include <list>
+#include <memory>
+#include <unordered_map>
 #include <utility>
 #include <functional>
 
@@ -24,19 +33,35 @@
 
 
 namespace noct {
+  constexpr std::size_t CHECKPOINT_PAGE_SIZE = 4096;
+  constexpr std::size_t TAPE_CALL_DEPTH      = 1024;
+  constexpr std::size_t MEMO_CAPACITY        = 256;
+
+  class NativeScript;
+  class TapeError;
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+  template<typename T>
+  using TapeStack = GuardedStack<T>;
+#else
+  template<typename T>
+  using TapeStack = std::vector<T>;
+#endif
 
   class NoctSysAPI TapeVM
   {
-    std::vector<std::uintptr_t>     m_stack;
-    std::vector<std::uintptr_t>     m_rstack;
-    std::vector<float>              m_fstack;
+    TapeStack<std::uintptr_t>       m_stack;
+    TapeStack<std::uintptr_t>       m_rstack;
+    TapeStack<float>                m_fstack;
     std::string                     m_lastDefinition;
     InputStream                     m_input;
     OutputStream                    m_output;
     std::vector<std::unique_ptr<OutputSource<char>>>
                                     m_ostack;
-    bool                            m_isAllocating;
+    bool                            m_isAllocating,
+                                    m_lazyIncludes;
     std::vector<std::string>        m_includeDirectories;
+    IncludeIndex                    m_includeIndex;
 
   public:
     TapeVM();
@@ -51,6 +76,8 @@ namespace noct {
     };
 
     typedef std::function<void(TapeVM&)>  Function;
+    typedef std::function<void(TapeVM&, const TapeError&)>
+                                          TraceHandler;
 
     struct FuncdatPair {
       Function       func; 
@@ -77,7 +104,8 @@ namespace noct {
       std::size_t    size;
       std::uintptr_t data;
       bool           free,
-                     pinned;
+                     pinned,
+                     mapped { false };
     };
     
     typedef std::vector<MemTag> HeapArena;
@@ -107,18 +135,141 @@ namespace noct {
 
     typedef std::vector<ControlFrame> ControlStack;
 
+    struct LazyWord {
+      std::shared_ptr<const std::string> source;
+      std::size_t                        offset,
+                                         length;
+      std::vector<std::string_view>      uses;
+    };
+
+    typedef std::map<std::string, LazyWord>                     LazyDictionary;
+    typedef std::map<std::size_t, std::pair<std::string, LazyWord>> DeferredList;
+    typedef std::map<std::string, std::set<std::string>>        LazyUsers;
+
+    struct FieldTag {
+      std::string name;
+      std::size_t offset,
+                  size,
+                  column;
+      bool        real;
+    };
+
+    struct RecordTag {
+      std::string           name;
+      std::vector<FieldTag> fields;
+      std::size_t           size { 0ul };
+    };
+
+    typedef std::vector<std::unique_ptr<RecordTag>> RecordList;
+
+    struct MemoKeyHash {
+      std::size_t operator()(const std::vector<std::uintptr_t>& key) const {
+        std::size_t h = 14695981039346656037ull;
+
+        for (auto cell : key)
+          h = (h ^ cell) * 1099511628211ull;
+
+        return h;
+      }
+    };
+
+    struct MemoEntry {
+      std::vector<std::uintptr_t> key,
+                                  result;
+    };
+
+    struct MemoTag {
+      std::string          name;
+      std::size_t          in,
+                           out;
+      const Word*          body;
+      std::list<MemoEntry> lru;
+      std::unordered_map<std::vector<std::uintptr_t>, std::list<MemoEntry>::iterator, MemoKeyHash>
+                           index;
+      std::size_t          hits      { 0ul },
+                           misses    { 0ul },
+                           evictions { 0ul };
+    };
+
+    struct MemoStats {
+      std::string name;
+      std::size_t hits,
+                  misses,
+                  evictions,
+                  entries;
+    };
+
+    typedef std::vector<std::unique_ptr<MemoTag>> MemoList;
+
+    typedef std::shared_ptr<const std::vector<std::uint8_t>> CheckpointPage;
+
+    struct BlockImage {
+      MemTag                      tag;
+      std::vector<CheckpointPage> pages;
+    };
+
+    // a Checkpoint shares the dictionary with its VM and must not outlive it;
+    // words defined after it keep their heap blocks across a restore
+    struct Checkpoint {
+      std::vector<std::uintptr_t> stack,
+                                  rstack;
+      std::vector<float>          fstack;
+      XVector                     exec;
+      ControlStack                cstack;
+      InputMode                   mode;
+      std::vector<std::uint8_t>   scratch;
+      std::vector<BlockImage>     heap;
+      std::size_t                 epoch;
+      std::shared_ptr<void>       lease;
+    };
+
   private:
-    ControlStack m_cstack;
-    InputMode    m_mode;
-    Dictionary   m_dict;
-    XVector      m_exec;
-    HeapArena    m_mem;
-    ScratchArena m_smem;
+    ControlStack   m_cstack;
+    InputMode      m_mode;
+    Dictionary     m_dict;
+    XVector        m_exec;
+    HeapArena      m_mem;
+    ScratchArena   m_smem;
+    LazyDictionary m_lazy;
+    DeferredList   m_deferred;
+    LazyUsers      m_lazyUsers;
+    std::size_t    m_deferredId { 0ul };
+    HeapArena      m_retired;
+    std::map<std::uintptr_t, std::size_t>
+                   m_holds;
+    std::unordered_map<std::uintptr_t, std::vector<bool>>
+                   m_dirty;
+    std::size_t    m_epoch { 0ul };
+    RecordList     m_records;
+    RecordTag*     m_openRecord { nullptr };
+    MemoList       m_memos;
+    std::map<std::uintptr_t, std::unique_ptr<MappedFile>>
+                   m_mapped;
+    RegionIndex    m_regions;
+    std::map<std::string, std::shared_ptr<NativeScript>>
+                   m_natives;
+    bool           m_sandboxed    { false },
+                   m_regionsDirty { true };
+#if defined(NOCTSYS_TAPE_TRACE)
+    TraceRing      m_trace;
+    TraceHandler   m_traceHandler;
+    std::size_t    m_executing    { 0ul };
+#endif
 
   public:
     void             addIncludeDirectory(const std::string& directory);
     std::string      convertModname(std::string modname);
     std::string      convertDirectory(std::string directory, const std::string& modname);
+    std::filesystem::path
+                     findModule(const std::string& modname);
+    void             include(const std::string& modname);
+    void             rescanIncludes();
+    IncludeIndex::Stats
+                     includeStats();
+    std::string      deferDefinitions(const std::shared_ptr<const std::string>& source);
+    void             reachDeferred(std::size_t id);
+    void             setLazyIncludes(bool flag);
+    bool             isLazyIncluding();
 
     void             setAllocating(bool flag);
     bool             isAllocating();
@@ -143,7 +294,8 @@ namespace noct {
     void            xpush(const Word& word);
     XToken&         getExecuting();
     void            jump(int branches);
-    void            execute();
+    void            execute(InputMode mode=InputMode::Executing);
+    void            call(const Word& word, InputMode mode=InputMode::Executing);
 
     std::uintptr_t  allot(std::size_t sz);
     bool            isScratchData(std::uintptr_t p);
@@ -155,6 +307,64 @@ namespace noct {
     void            freeMem(std::uintptr_t p);
     MemTag*         findMem(std::uintptr_t p);
     void            setPinned(std::uintptr_t word, bool flag=true);
+    std::uintptr_t  mapFile(const std::filesystem::path& path, std::size_t& size);
+    void            unmapFile(std::uintptr_t p);
+
+    // NATIVE: resolves symbols in the scripts registered here
+    void            addNativeScript(const std::string& name, const std::shared_ptr<NativeScript>& script);
+
+    void            setSandboxed(bool flag);
+    bool            isSandboxed();
+
+    // in sandboxed mode the memory words only touch live heap blocks, the
+    // allotted scratch arena and (read only) mapped files, words only call
+    // execution tokens from the dictionary, and no word opens a host path
+    bool isAccessible(std::uintptr_t addr, std::size_t size, bool write) {
+      if (!m_regionsDirty && m_regions.contains(addr, size, write))
+        return true;
+
+      return isAccessibleSlow(addr, size, write);
+    }
+
+    void checkAccess(std::uintptr_t addr, std::size_t size, bool write, const char* word) {
+      if (m_sandboxed && !isAccessible(addr, size, write))
+        accessFault(addr, word);
+
+      if (write)
+        touch(addr, size);
+    }
+
+    // for pointers a word reads out of script memory, like a map's slot
+    // table: in sandboxed mode addr has to start a live heap block of at
+    // least size bytes
+    void checkBlock(std::uintptr_t addr, std::size_t size, const char* word) {
+      if (m_sandboxed && !isHeapBlock(addr, size))
+        accessFault(addr, word);
+    }
+
+    // while a checkpoint is held, records the pages of the heap block at
+    // addr written since the last one (the whole block for a size of 0).
+    // The store words do this; host code writing into the heap directly
+    // has to as well
+    void touch(std::uintptr_t addr, std::size_t size) {
+      if (!m_holds.empty())
+        markDirty(addr, size);
+    }
+
+    bool isHeapBlock(std::uintptr_t addr, std::size_t size);
+    bool isExecutionToken(std::uintptr_t xt);
+    void checkHostPath(const char* word);
+
+    // without NOCTSYS_TAPE_TRACE nothing is recorded and the dump is empty
+    void            dumpTrace(std::ostream& out, bool binary=false);
+    void            clearTrace();
+
+    // handler sees each TapeError once, as it leaves the outermost execute,
+    // while the ring still holds the words that led to it
+    void            setTraceHandler(TraceHandler handler);
+
+    Checkpoint      checkpoint(const Checkpoint* base=nullptr);
+    void            restore(const Checkpoint& checkpoint);
 
     void            push(std::uintptr_t cell);
     std::uintptr_t& top();
@@ -174,6 +384,24 @@ namespace noct {
     float           fpop();
     std::size_t     fstackSize();
 
+    // underflow checks for primitives
+    bool            hasCells(std::size_t n)  const { return m_stack.size()  >= n; }
+    bool            hasRCells(std::size_t n) const { return m_rstack.size() >= n; }
+    bool            hasFCells(std::size_t n) const { return m_fstack.size() >= n; }
+
+    // with guarded stacks these fold away and underflow is caught by the
+    // guard pages; a fault skips the primitive's frame, so only primitives
+    // holding nothing with a destructor may use them
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+    constexpr bool  guardedCells(std::size_t)  const { return true; }
+    constexpr bool  guardedRCells(std::size_t) const { return true; }
+    constexpr bool  guardedFCells(std::size_t) const { return true; }
+#else
+    bool            guardedCells(std::size_t n)  const { return hasCells(n); }
+    bool            guardedRCells(std::size_t n) const { return hasRCells(n); }
+    bool            guardedFCells(std::size_t n) const { return hasFCells(n); }
+#endif
+
     void            cpush(const ControlFrame& frame);
     ControlFrame&   ctop();
     ControlFrame    cpop();
@@ -181,6 +409,10 @@ namespace noct {
 
     void            clearStacks();
 
+    std::vector<MemoStats>
+                    memoStats();
+    void            clearMemos();
+
     std::string    getNext();
 
     bool           isInteger(const std::string& word);
@@ -189,6 +421,10 @@ namespace noct {
     float          toRealnum(const std::string& word);
 
     void           processToken(const std::string& token);
+    void           processWord(const WordTag& word, const std::string_view& name);
+    void           processInteger(std::uintptr_t number);
+    void           processRealnum(float number);
+    void           evaluate(const std::string& source);
     void           loadTapeBase();
 
     void operator<<(const std::string& s) {
@@ -206,5 +442,27 @@ namespace noct {
     void loadParsingWords();
     void loadVariableDefiners();
     void loadStdIO();
+    void loadMaps();
+    void loadRecords();
+    void loadMemo();
+    void loadMappedFiles();
+    void loadTracing();
+    void loadNatives();
+
+    void     dispatch(std::size_t depth);
+    void     dispatchGuarded(std::size_t depth, InputMode lastMode);
+    void     indexRegions();
+    bool     isAccessibleSlow(std::uintptr_t addr, std::size_t size, bool write);
+    void     markDirty(std::uintptr_t addr, std::size_t size);
+    [[noreturn]] void accessFault(std::uintptr_t addr, const char* word);
+
+    WordTag* compileLazy(LazyDictionary::iterator it);
+    void     settleLazy(const std::string& name);
+    void     retire(MemTag& tag);
+    void     release(const std::vector<std::uintptr_t>& blocks);
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+    [[noreturn]] void fault(const guard::Scope& scope, InputMode lastMode);
+#endif
   };
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+/* GuardedStack.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <setjmp.h>
+
+namespace noct {
+  constexpr std::size_t TAPE_STACK_CELLS = 64 * 1024;
+
+  // a fixed mapping between two PROT_NONE guard pages
+  class NoctSysAPI GuardedRegion
+  {
+    std::uint8_t* m_base;
+    std::size_t   m_length,
+                  m_guard;
+
+  public:
+    enum Side {
+      None,
+      Below,
+      Above
+    };
+
+    explicit GuardedRegion(std::size_t bytes);
+    ~GuardedRegion();
+
+    GuardedRegion(const GuardedRegion&)            = delete;
+    GuardedRegion& operator=(const GuardedRegion&) = delete;
+
+    void* begin() const;
+    void* end() const;
+    Side  classify(const void* address) const;
+  };
+
+
+  // a stack of cells with no bounds checks on the way down: popping past
+  // the bottom touches a guard page, and the fault is raised as a TapeError
+  // by TapeVM::dispatchGuarded. A push checks for room, since primitives of
+  // every kind push
+  template<typename T>
+  class GuardedStack
+  {
+    GuardedRegion m_region;
+    T*            m_base;
+    T*            m_top;
+    T*            m_limit;
+
+  public:
+    explicit GuardedStack(std::size_t cells=TAPE_STACK_CELLS)
+      : m_region(cells * sizeof(T)),
+        m_base(static_cast<T*>(m_region.begin())),
+        m_top(m_base),
+        m_limit(static_cast<T*>(m_region.end()))
+    {}
+
+    GuardedStack(const GuardedStack&)            = delete;
+    GuardedStack& operator=(const GuardedStack&) = delete;
+
+    GuardedStack& operator=(const std::vector<T>& cells) {
+      if (cells.size() > std::size_t(m_limit - m_base))
+        throw TapeError("Stack Overflow", "restore");
+
+      m_top = m_base;
+
+      for (const auto& cell : cells)
+        *m_top++ = cell;
+
+      return *this;
+    }
+
+    operator std::vector<T>() const {
+      return std::vector<T>(m_base, m_top);
+    }
+
+    void push_back(T cell) {
+      if (m_top == m_limit)
+        throw TapeError("Stack Overflow", "push");
+
+      *m_top++ = cell;
+    }
+
+    void        pop_back()                     { --m_top; }
+    T&          back()                         { return m_top[-1]; }
+    T&          operator[](std::size_t index)  { return m_base[index]; }
+    std::size_t size() const                   { return std::size_t(m_top - m_base); }
+    bool        empty() const                  { return m_top == m_base; }
+    void        clear()                        { m_top = m_base; }
+    T*          begin()                        { return m_base; }
+    T*          end()                          { return m_top; }
+
+    const GuardedRegion& region() const        { return m_region; }
+
+    // after a fault the top may have been left past either end
+    void recover() {
+      if (m_top < m_base)
+        m_top = m_base;
+
+      else if (m_top > m_limit)
+        m_top = m_limit;
+    }
+  };
+
+
+  namespace guard {
+    struct Scope {
+      sigjmp_buf           jump;
+      const GuardedRegion* regions[3];
+      GuardedRegion::Side  side;
+      Scope*               prev;
+    };
+
+    NoctSysAPI void enter(Scope& scope);
+    NoctSysAPI void leave(Scope& scope);
+  }
+}
+
+#endif
\ No newline at end of file
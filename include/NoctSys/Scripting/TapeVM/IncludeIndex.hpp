@@ -0,0 +1,61 @@
+/* IncludeIndex.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace noct {
+  class NoctSysAPI IncludeIndex
+  {
+  public:
+    struct Stats {
+      std::size_t hits          { 0ul },
+                  negativeHits  { 0ul },
+                  misses        { 0ul },
+                  scans         { 0ul },
+                  invalidations { 0ul };
+    };
+
+  private:
+    struct Listing {
+      bool                            exists;
+      std::unordered_set<std::string> entries;
+    };
+
+    mutable std::mutex                                     m_mutex;
+    std::unordered_map<std::string, std::filesystem::path> m_resolved;
+    std::unordered_map<std::string, Listing>               m_listings;
+    Stats                                                  m_stats;
+
+#if defined(__NoctSys_Linux__)
+    int                                                    m_inotify;
+#endif
+
+  public:
+    IncludeIndex();
+    ~IncludeIndex();
+
+    IncludeIndex(const IncludeIndex&)            = delete;
+    IncludeIndex& operator=(const IncludeIndex&) = delete;
+
+    bool  lookup(const std::string& modname, std::filesystem::path& path);
+    bool  exists(const std::filesystem::path& path);
+    void  insert(const std::string& modname, const std::filesystem::path& path);
+    void  forget();
+    void  rescan();
+    Stats stats() const;
+
+  private:
+    void     poll();
+    Listing& list(const std::string& directory);
+    void     watch(const std::filesystem::path& directory);
+  };
+}
\ No newline at end of file
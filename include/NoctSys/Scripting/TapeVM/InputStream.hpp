@@ -16,13 +16,16 @@ namespace noct {
   class NoctSysAPI InputStream 
   {
     std::vector<std::unique_ptr<InputSource>> m_stack;
+    std::size_t                               m_floor { 0ul };
 
   public:
     
-    void push(InputSource* ptr);
-    void pop();
-    bool eof() const;
-    int  get();
-    void unget();
+    void        push(InputSource* ptr);
+    void        pop();
+    bool        eof() const;
+    int         get();
+    void        unget();
+    std::size_t depth() const;
+    std::size_t setFloor(std::size_t floor);
   };
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+/* ModuleGraph.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Scripting/TapeVM.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace noct {
+  // the INCLUDE graph of a set of root modules. read() resolves, reads and
+  // scans the modules on worker threads; compile() then compiles them on
+  // the owning VM one at a time, since compiled words close over the VM
+  // that compiled them and cannot be merged from another
+  class NoctSysAPI ModuleGraph
+  {
+  public:
+    struct Module {
+      std::string                        modname;
+      std::filesystem::path              path;
+      std::shared_ptr<const std::string> source;
+      std::vector<std::string>           includes,
+                                         definitions;
+    };
+
+    struct Conflict {
+      std::string              word;
+      std::vector<std::string> modules;
+    };
+
+    typedef std::map<std::string, Module> ModuleMap;
+    typedef std::vector<Conflict>         ConflictVector;
+
+  private:
+    TapeVM&                  m_vm;
+    std::size_t              m_threads;
+    ModuleMap                m_modules;
+    std::vector<std::string> m_order;
+    ConflictVector           m_conflicts;
+
+  public:
+    explicit ModuleGraph(TapeVM& vm, std::size_t threads=0ul);
+
+    void                            read(const std::vector<std::string>& modnames);
+    void                            compile();
+
+    const ModuleMap&                modules() const;
+    const std::vector<std::string>& order() const;
+    const ConflictVector&           conflicts() const;
+
+  private:
+    void discover(const std::vector<std::string>& roots);
+    void sort(const std::vector<std::string>& roots);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+/* ModuleScanner.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace noct {
+  class NoctSysAPI ModuleScanner
+  {
+  public:
+    struct Definition {
+      std::string                   name;
+      std::size_t                   offset,
+                                    length;
+      bool                          immediate { false },
+                                    interprets { false };
+      std::vector<std::string_view> words;
+    };
+
+    struct Include {
+      std::string modname;
+      std::size_t offset,
+                  length;
+    };
+
+    typedef std::vector<Definition> DefinitionVector;
+    typedef std::vector<Include>    IncludeVector;
+
+  private:
+    std::string_view m_source;
+    std::size_t      m_pos;
+    DefinitionVector m_definitions;
+    IncludeVector    m_includes;
+
+  public:
+    explicit ModuleScanner(std::string_view source);
+
+    const DefinitionVector& definitions() const;
+    const IncludeVector&    includes() const;
+
+  private:
+    std::string_view next();
+    void             skipUntil(char delim);
+    void             skipComment();
+    void             scan();
+  };
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/* RegionIndex.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace noct {
+  // sorted, non overlapping address intervals; lookups try the last region
+  // that matched before falling back to a branchless binary search over
+  // the packed start addresses
+  class NoctSysAPI RegionIndex
+  {
+    struct Region {
+      std::uintptr_t begin,
+                     end;
+      bool           writable;
+    };
+
+    std::vector<Region>         m_regions;
+    std::vector<std::uintptr_t> m_begins;
+    std::size_t                 m_last;
+
+  public:
+    RegionIndex();
+
+    void        clear();
+    void        insert(std::uintptr_t begin, std::size_t size, bool writable);
+    void        sort();
+    std::size_t size() const;
+    bool        find(std::uintptr_t addr, std::uintptr_t& begin, std::size_t& size);
+
+    bool contains(std::uintptr_t addr, std::size_t size, bool write) {
+      if (m_last < m_regions.size()) {
+        const auto& region = m_regions[m_last];
+
+        if (addr >= region.begin && addr + size <= region.end && addr + size >= addr)
+          return region.writable || !write;
+      }
+
+      return search(addr, size, write);
+    }
+
+  private:
+    bool search(std::uintptr_t addr, std::size_t size, bool write);
+  };
+}
\ No newline at end of file
@@ -0,0 +1,438 @@
+/* StaticTape.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* A StaticTape is a Tape string literal that has been tokenised at compile time:
+ *
+ *   static constexpr auto glue = noct::compileTape("#2 #3 + . cr");
+ *   vm.addWord("glue", glue.bind());
+ *
+ * Numbers are converted, comments are stripped and the arguments of the base
+ * parsing words are split off while the build runs, so a malformed literal fails
+ * the build. Words are looked up in the dictionary the first time each one runs.
+ * User defined parsing words are not known at compile time and cannot be used.
+ */
+
+namespace noct {
+  struct TapeOp {
+    enum Type
+      : std::uint8_t
+    {
+      Word,
+      Integer,
+      Realnum,
+      Parsing
+    };
+
+    Type           type      { Word };
+    std::size_t    offset    { 0ul },
+                   length    { 0ul },
+                   argOffset { 0ul },
+                   argLength { 0ul };
+    std::uintptr_t integer   { 0ul };
+    float          real      { 0.f };
+  };
+
+
+  namespace tape {
+    constexpr bool isSpace(char ch) {
+      return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+    }
+
+    constexpr int digitValue(char ch) {
+      if (ch >= '0' && ch <= '9') return ch - '0';
+      if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+      if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+      return -1;
+    }
+
+    constexpr bool takesName(std::string_view word) {
+      constexpr std::string_view words[] = {
+        ":", "VARIABLE", "CREATE", "CONSTANT", "SCONSTANT", "FCONSTANT",
+        "'", "CHAR", "[CHAR]", "[']", "POSTPONE", "INCLUDE", "parse-name",
+        "(LIT)", "(FLIT)", "(JMP)", "(0JMP)", "(BRANCH)"
+      };
+
+      for (auto w : words) {
+        if (w == word)
+          return true;
+      }
+      return false;
+    }
+
+    constexpr std::uintptr_t toInteger(std::string_view word) {
+      std::uintptr_t output   = 0ul,
+                     base     = 10ul;
+      std::size_t    i        = 1ul;
+      bool           negative = false;
+
+      switch (word[0]) {
+        case '#':
+          base = 10ul;
+          if (word.length() > 1 && word[1] == '-') {
+            negative = true;
+            i++;
+          }
+          break;
+        case '$': base = 16ul; break;
+        case '%': base = 2ul;  break;
+        default:
+          throw TapeError("Not An Integral Number", word);
+      }
+
+      if (i >= word.length())
+        throw TapeError("Not An Integral Number", word);
+
+      for (; i < word.length(); i++) {
+        int digit = digitValue(word[i]);
+
+        if (digit < 0 || std::uintptr_t(digit) >= base)
+          throw TapeError("Not An Integral Number", word);
+
+        output = output * base + std::uintptr_t(digit);
+      }
+
+      return negative ? std::uintptr_t(0ul) - output : output;
+    }
+
+    constexpr float toRealnum(std::string_view word) {
+      double      mantissa = 0.0,
+                  scale    = 1.0;
+      int         exponent = 0;
+      bool        negative = false,
+                  point    = false,
+                  digits   = false;
+      std::size_t i        = 1ul;
+
+      if (word.empty() || word[0] != '&')
+        throw TapeError("Not A Real Number", word);
+
+      if (i < word.length() && word[i] == '-') {
+        negative = true;
+        i++;
+      }
+
+      for (; i < word.length() && word[i] != 'e'; i++) {
+        char ch = word[i];
+
+        if (ch == '.' && !point)
+          point = true;
+
+        else if (ch >= '0' && ch <= '9') {
+          digits = true;
+
+          if (point) {
+            scale    /= 10.0;
+            mantissa += (ch - '0') * scale;
+          }
+          else mantissa = mantissa * 10.0 + (ch - '0');
+        }
+        else throw TapeError("Not A Real Number", word);
+      }
+
+      if (!digits)
+        throw TapeError("Not A Real Number", word);
+
+      if (i < word.length()) {
+        bool negExp = false;
+
+        if (++i < word.length() && (word[i] == '-' || word[i] == '+'))
+          negExp = word[i++] == '-';
+
+        if (i >= word.length())
+          throw TapeError("Not A Real Number", word);
+
+        for (; i < word.length(); i++) {
+          if (word[i] < '0' || word[i] > '9')
+            throw TapeError("Not A Real Number", word);
+
+          exponent = exponent * 10 + (word[i] - '0');
+        }
+
+        if (negExp)
+          exponent = -exponent;
+      }
+
+      for (; exponent > 0; exponent--) mantissa *= 10.0;
+      for (; exponent < 0; exponent++) mantissa /= 10.0;
+
+      return float(negative ? -mantissa : mantissa);
+    }
+  }
+
+
+  template<std::size_t N>
+  class StaticTape
+  {
+    static constexpr std::size_t Capacity = N / 2 + 1;
+
+    std::array<char, N>          m_source;
+    std::array<TapeOp, Capacity> m_ops;
+    std::size_t                  m_count;
+
+  public:
+    constexpr explicit StaticTape(const char (&source)[N])
+      : m_source(), m_ops(), m_count(0ul)
+    {
+      for (std::size_t i = 0; i < N; i++)
+        m_source[i] = source[i];
+
+      std::size_t length = N ? N - 1 : 0ul,
+                  pos    = 0ul,
+                  depth  = 0ul;
+
+      while (pos < length) {
+        while (pos < length && tape::isSpace(m_source[pos]))
+          pos++;
+
+        if (pos >= length)
+          break;
+
+        std::size_t start = pos;
+
+        while (pos < length && !tape::isSpace(m_source[pos]))
+          pos++;
+
+        std::string_view word(m_source.data() + start, pos - start);
+        TapeOp           op;
+
+        op.offset = start;
+        op.length = pos - start;
+
+        if (word == "\\") {
+          while (pos < length && m_source[pos] != '\n')
+            pos++;
+          continue;
+        }
+        else if (word == "(*" || word == "(**") {
+          bool closed = false;
+
+          while (pos < length && !closed) {
+            while (pos < length && tape::isSpace(m_source[pos]))
+              pos++;
+
+            std::size_t from = pos;
+
+            while (pos < length && !tape::isSpace(m_source[pos]))
+              pos++;
+
+            closed = std::string_view(m_source.data() + from, pos - from) == "*)";
+          }
+
+          if (!closed)
+            throw TapeError("Unclosed comment", word);
+          continue;
+        }
+        else if (word == "(") {
+          std::size_t from = pos;
+
+          while (pos < length && m_source[pos] != ')')
+            pos++;
+
+          if (pos >= length)
+            throw TapeError("Unclosed comment", word);
+
+          pos++;
+
+          if (!depth)
+            continue;
+
+          op.type      = TapeOp::Parsing;
+          op.argOffset = from;
+          op.argLength = pos - from;
+        }
+        else if (word == "s\"" || word == "c\"") {
+          std::size_t from = pos;
+
+          while (pos < length && m_source[pos] != '"')
+            pos++;
+
+          if (pos >= length)
+            throw TapeError("Unterminated string", word);
+
+          pos++;
+
+          op.type      = TapeOp::Parsing;
+          op.argOffset = from;
+          op.argLength = pos - from;
+        }
+        else if (word == "parse") {
+          throw TapeError("Cannot compile a runtime delimiter statically", word);
+        }
+        else if (tape::takesName(word)) {
+          std::size_t from = pos;
+
+          while (pos < length && tape::isSpace(m_source[pos]))
+            pos++;
+
+          if (pos >= length)
+            throw TapeError("Missing name", word);
+
+          while (pos < length && !tape::isSpace(m_source[pos]))
+            pos++;
+
+          if (word == ":") {
+            if (depth)
+              throw TapeError("Nested definition", word);
+            depth++;
+          }
+
+          op.type      = TapeOp::Parsing;
+          op.argOffset = from;
+          op.argLength = pos - from;
+        }
+        else if (word[0] == '#' || word[0] == '$' || word[0] == '%') {
+          op.type    = TapeOp::Integer;
+          op.integer = tape::toInteger(word);
+        }
+        else if (word[0] == '&') {
+          op.type = TapeOp::Realnum;
+          op.real = tape::toRealnum(word);
+        }
+        else if (word == ";") {
+          if (!depth)
+            throw TapeError("Compile Only Word", word);
+          depth--;
+        }
+
+        m_ops[m_count++] = op;
+      }
+
+      if (depth)
+        throw TapeError("Unclosed definition", "StaticTape");
+    }
+
+    constexpr std::size_t size() const {
+      return m_count;
+    }
+
+    constexpr const TapeOp& operator[](std::size_t index) const {
+      return m_ops[index];
+    }
+
+    constexpr std::string_view text(const TapeOp& op) const {
+      return std::string_view(m_source.data() + op.offset, op.length);
+    }
+
+    constexpr std::string_view argument(const TapeOp& op) const {
+      return std::string_view(m_source.data() + op.argOffset, op.argLength);
+    }
+
+    TapeVM::Function bind() const {
+      return [tape = *this, vm = (TapeVM*)nullptr, words = std::vector<TapeVM::WordTag*>(m_count)](TapeVM& context) mutable {
+        if (vm != &context) {
+          std::fill(words.begin(), words.end(), nullptr);
+          vm = &context;
+        }
+
+        tape.runAll(context, words.data());
+      };
+    }
+
+    void operator()(TapeVM& context) const {
+      runAll(context, nullptr);
+    }
+
+  private:
+    // a bound tape runs inside the word that holds it, where the VM is
+    // Executing; the ops are interpreted as if typed, and words run through
+    // call so the frames below are left alone. A : in the tape keeps the
+    // mode it sets, the same as it would from input
+    void runAll(TapeVM& context, TapeVM::WordTag** words) const {
+      auto lastMode = context.getInputMode();
+
+      if (lastMode == TapeVM::InputMode::Executing)
+        context.setInputMode(TapeVM::InputMode::Interpreting);
+
+      try {
+        for (std::size_t i = 0; i < size(); i++) {
+          TapeVM::WordTag* word = nullptr;
+          run(context, m_ops[i], words ? words[i] : word);
+        }
+      }
+      catch (...) {
+        context.setInputMode(lastMode);
+        throw;
+      }
+
+      if (lastMode == TapeVM::InputMode::Executing && context.getInputMode() == TapeVM::InputMode::Interpreting)
+        context.setInputMode(lastMode);
+    }
+
+    static void perform(TapeVM& context, const TapeVM::WordTag& word, std::string_view name) {
+      auto mode = context.getInputMode();
+
+      if (mode == TapeVM::InputMode::Compiling && !word.immediate)
+        context.processWord(word, name);
+
+      else context.call(word.code, word.immediate && word.code.size() == 1 ? mode : TapeVM::InputMode::Executing);
+    }
+
+    void run(TapeVM& context, const TapeOp& op, TapeVM::WordTag*& word) const {
+      switch (op.type) {
+        case TapeOp::Integer:
+          context.processInteger(op.integer);
+          break;
+
+        case TapeOp::Realnum:
+          context.processRealnum(op.real);
+          break;
+
+        case TapeOp::Word:
+        case TapeOp::Parsing:
+        {
+          auto name = text(op);
+
+          if (!word && !(word = context.findWord(name)))
+            throw TapeError("Unknown Word", name);
+
+          if (op.type == TapeOp::Word) {
+            perform(context, *word, name);
+            break;
+          }
+
+          auto& input = context.input();
+          auto  depth = input.depth();
+
+          input.push(new StringInputSource(std::string(argument(op)) + ' '));
+          auto floor = input.setFloor(depth);
+
+          try {
+            perform(context, *word, name);
+          }
+          catch (...) {
+            while (input.depth() > depth)
+              input.pop();
+
+            input.setFloor(floor);
+            throw;
+          }
+
+          while (input.depth() > depth)
+            input.pop();
+
+          input.setFloor(floor);
+        } break;
+      }
+    }
+  };
+
+
+  template<std::size_t N>
+  constexpr StaticTape<N> compileTape(const char (&source)[N]) {
+    return StaticTape<N>(source);
+  }
+}
\ No newline at end of file
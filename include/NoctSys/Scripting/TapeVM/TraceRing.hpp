@@ -0,0 +1,56 @@
+/* TraceRing.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace noct {
+  constexpr std::size_t TAPE_TRACE_EVENTS = 4096;
+
+  static_assert((TAPE_TRACE_EVENTS & (TAPE_TRACE_EVENTS - 1)) == 0, "TAPE_TRACE_EVENTS must be a power of two");
+
+  struct TraceEvent {
+    std::uintptr_t word;
+    std::uint32_t  ip,
+                   depth;
+    std::uint64_t  time;
+  };
+
+  // a fixed ring of the last TAPE_TRACE_EVENTS frame entries; recording
+  // overwrites the oldest event and never allocates
+  class NoctSysAPI TraceRing
+  {
+    std::vector<TraceEvent> m_events;
+    std::uint64_t           m_count;
+
+  public:
+    typedef std::function<std::string(std::uintptr_t)> Namer;
+
+    TraceRing();
+
+    void record(std::uintptr_t word, std::size_t ip, std::size_t depth) {
+      auto& event = m_events[m_count++ & (TAPE_TRACE_EVENTS - 1)];
+
+      event.word  = word;
+      event.ip    = static_cast<std::uint32_t>(ip);
+      event.depth = static_cast<std::uint32_t>(depth);
+      event.time  = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    std::vector<TraceEvent> events() const;
+    std::uint64_t           recorded() const;
+    void                    clear();
+
+    void writeText(std::ostream& out, const Namer& name) const;
+    void writeBinary(std::ostream& out, const Namer& name) const;
+  };
+}
\ No newline at end of file
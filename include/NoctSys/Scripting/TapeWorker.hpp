@@ -0,0 +1,81 @@
+/* TapeWorker.hpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#pragma once
+
+#include <NoctSys/Configuration.hxx>
+#include <NoctSys/Scripting/TapeVM.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace noct {
+  class NoctSysAPI TapeWorker
+  {
+  public:
+    struct Result {
+      std::vector<std::uintptr_t> stack;
+      std::vector<float>          fstack;
+      std::string                 output;
+    };
+
+    typedef std::function<void(Result&, std::exception_ptr)> Callback;
+
+  private:
+    struct Job {
+      enum Type {
+        Eval,
+        Call,
+        Stop
+      }                           type;
+      std::string                 text;
+      std::vector<std::uintptr_t> args;
+      std::promise<Result>        promise;
+      Callback                    callback;
+      Result                      result;
+      std::exception_ptr          error;
+      std::atomic<Job*>           next { nullptr };
+    };
+
+    TapeVM                  m_vm;
+    Job                     m_stub;
+    std::atomic<Job*>       m_head;
+    Job*                    m_tail;
+    std::atomic<std::size_t>
+                            m_pending;
+    std::atomic<bool>       m_sleeping;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::mutex              m_doneMutex;
+    std::vector<Job*>       m_done;
+    std::thread             m_thread;
+
+  public:
+    explicit TapeWorker(const TapeVM::Function& setup={});
+    ~TapeWorker();
+
+    TapeWorker(const TapeWorker&)            = delete;
+    TapeWorker& operator=(const TapeWorker&) = delete;
+
+    std::future<Result> eval(const std::string& source);
+    std::future<Result> call(const std::string& word, const std::vector<std::uintptr_t>& args={});
+    void                eval(const std::string& source, const Callback& callback);
+    void                call(const std::string& word, const std::vector<std::uintptr_t>& args, const Callback& callback);
+    std::size_t         collect();
+    std::size_t         pending() const;
+
+  private:
+    void push(Job* job);
+    Job* pop();
+    void run(const TapeVM::Function& setup);
+    void process(Job& job);
+  };
+}
\ No newline at end of file
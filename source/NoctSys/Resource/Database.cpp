@@ -3,35 +3,94 @@
  * BSD-2-Clause
  */
 #include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Resource/ResourcePack.hpp>
+#include <NoctSys/Resource/ManifestCache.hpp>
 #include <NoctSys/Exception/ResourceError.hpp>
 
 #include <fstream>
 #include <iomanip>
+#include <iterator>
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <exception>
 #include <string>
 
 namespace noct {
+  namespace {
+    // the readers only walk elements, attributes and text; escapes are kept
+    // for inline shader code and CDATA in case it is wrapped in one
+    constexpr unsigned int MANIFEST_PARSE_FLAGS = pugi::parse_minimal | pugi::parse_escapes | pugi::parse_cdata;
+
+    // a loaded resource is held by its map entry, the writers' handle table
+    // and the published snapshot; anything past that is someone else's
+    constexpr long RESOURCE_INTERNAL_OWNERS = 3;
+
+    std::size_t fileBytes(const ManifestEntry& entry) {
+      std::error_code code;
+      auto            size = std::filesystem::file_size(entry.path, code);
+
+      return entry.data ? entry.size : code ? 0ul : static_cast<std::size_t>(size);
+    }
+
+    template<typename R>
+    auto valueOf(const R& res) -> decltype(res.data) {
+      return res.data;
+    }
+
+    ColorInt valueOf(ColorInt color) {
+      return color;
+    }
+
+    NativeScriptPtr valueOf(const NativeScriptPtr& script) {
+      return script;
+    }
+  }
+
+
   ResourceDatabase::ResourceDatabase()
-    : m_textures(), m_fonts(), m_sounds(), m_shaders(), m_colors(), m_mutex()
+    : m_textures(), m_fonts(), m_sounds(), m_shaders(), m_colors(), m_mutex(), m_batches(0ul), m_budgets(), m_tick(0ul), m_loaderStop(false)
   {}
 
 
-  ResourceDatabase::ResourceDatabase(const std::filesystem::path& xml_path) 
-    : m_textures(), m_fonts(), m_sounds(), m_shaders(), m_colors(), m_mutex()
+  ResourceDatabase::ResourceDatabase(const std::filesystem::path& xml_path, LoadMode mode) 
+    : m_textures(), m_fonts(), m_sounds(), m_shaders(), m_colors(), m_mutex(), m_batches(0ul), m_budgets(), m_tick(0ul), m_loaderStop(false)
   {
-    loadFromFile(xml_path);
+    loadFromFile(xml_path, mode);
   }
 
   ResourceDatabase::~ResourceDatabase() {
+    {
+      std::lock_guard<std::mutex> lock(m_loaderMutex);
+      m_loaderStop = true;
+    }
+
+    m_loaderWake.notify_all();
 
+    if (m_loader.joinable())
+      m_loader.join();
   }
 
 
-  void ResourceDatabase::loadFromFile(const std::filesystem::path& xml_path) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    pugi::xml_document     doc; 
-    pugi::xml_parse_result result = doc.load_file(xml_path.c_str());
+  // read whole into a buffer of its own and parsed in place, so the DOM's
+  // strings point into it. Not mapped: pugixml writes a terminator into
+  // nearly every page, so a private mapping copies as much, and a file
+  // truncated under the mapping would fault the parse with SIGBUS
+  ResourceManifest ResourceDatabase::readManifest(const std::filesystem::path& xml_path) {
+    std::ifstream      file(xml_path, std::ios::in | std::ios::binary);
+    pugi::xml_document doc;
+    ResourceManifest   manifest;
+    std::error_code    code;
+    auto               size = std::filesystem::file_size(xml_path, code);
+
+    if (!file.is_open() || code)
+      throw ResourceError(xml_path, "could not locate resource database");
+
+    std::vector<char> buffer(static_cast<std::size_t>(size));
+    file.read(buffer.data(), buffer.size());
+    buffer.resize(static_cast<std::size_t>(file.gcount()));
+
+    pugi::xml_parse_result result = doc.load_buffer_inplace(buffer.data(), buffer.size(), MANIFEST_PARSE_FLAGS);
     
     if (!result)
       throw ResourceError(xml_path, result.description());
@@ -42,12 +101,59 @@ namespace noct {
     if (version != NSRESDB_VERSION)
       throw ResourceError(xml_path, "invalid ResourceDatabase version: " + std::to_string(version));
 
-    readTextureDatabase(root);
-    readFontDatabase(root);
-    readSoundDatabase(root);
-    readShaderDatabase(root);
-    readColorDatabase(root);
-    readScriptDatabase(root);
+    readManifest(root, manifest);
+    return manifest;
+  }
+
+
+  // the cache is best effort; a read only install just parses every time
+  ResourceManifest ResourceDatabase::readCachedManifest(const std::filesystem::path& xml_path) {
+    auto          cache_path = ManifestCache::pathFor(xml_path);
+    ManifestCache cache;
+    ManifestStamp stamp;
+    std::string   error;
+
+    if (cache.open(cache_path, xml_path))
+      return cache.manifest();
+
+    bool stamped  = ManifestCache::stamp(xml_path, stamp);
+    auto manifest = readManifest(xml_path);
+
+    if (stamped)
+      ManifestCache::write(cache_path, stamp, manifest, error);
+
+    return manifest;
+  }
+
+
+  void ResourceDatabase::loadFromFile(const std::filesystem::path& xml_path, LoadMode mode) {
+    auto manifest = readCachedManifest(xml_path);
+
+    if (mode == LoadMode::Lazy)
+      registerManifest(manifest);
+
+    else loadManifest(manifest);
+  }
+
+
+  // entries decode straight out of the mapping, which stays open for as
+  // long as the database does
+  void ResourceDatabase::loadFromPack(const std::filesystem::path& pack_path, LoadMode mode) {
+    auto pack     = std::make_shared<ResourcePack>(pack_path);
+    auto manifest = pack->manifest();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_packs.push_back(pack);
+    }
+
+    if (mode == LoadMode::Lazy) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (const auto& entry : manifest.entries)
+        m_pending[{ entry.type, sf::String(entry.name) }] = { entry, {}, 0ul };
+    }
+    else loadManifest(manifest);
   }
 
 
@@ -192,119 +298,145 @@ namespace noct {
   }
 
 
-  void ResourceDatabase::readTextureDatabase(pugi::xml_node& root) {
+  // the DOM is only read from here on, so every section gets a thread and
+  // a manifest of its own, merged back in the order they were always read
+  void ResourceDatabase::readManifest(pugi::xml_node& root, ResourceManifest& manifest) {
+    typedef void (*Reader)(pugi::xml_node&, ResourceManifest&);
+
+    const Reader readers[] = {
+      &ResourceDatabase::readTextureDatabase,
+      &ResourceDatabase::readFontDatabase,
+      &ResourceDatabase::readSoundDatabase,
+      &ResourceDatabase::readShaderDatabase,
+      &ResourceDatabase::readColorDatabase,
+      &ResourceDatabase::readScriptDatabase
+    };
+
+    std::array<ResourceManifest, 6> parts;
+    std::vector<std::future<void>>  sections;
+
+    for (std::size_t i = 1; i < parts.size(); i++)
+      sections.push_back(std::async(std::launch::async, readers[i], std::ref(root), std::ref(parts[i])));
+
+    readers[0](root, parts[0]);
+
+    for (auto& section : sections)
+      section.get();
+
+    manifest.textureDirectory = parts[0].textureDirectory;
+    manifest.fontDirectory    = parts[1].fontDirectory;
+    manifest.soundDirectory   = parts[2].soundDirectory;
+    manifest.shaderDirectory  = parts[3].shaderDirectory;
+    manifest.colors           = std::move(parts[4].colors);
+    manifest.scriptDirectory  = parts[5].scriptDirectory;
+
+    for (auto& part : parts) {
+      manifest.entries.insert(manifest.entries.end(),
+                              std::make_move_iterator(part.entries.begin()),
+                              std::make_move_iterator(part.entries.end()));
+    }
+  }
+
+
+  void ResourceDatabase::readTextureDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto textureDB = root.child("TextureDatabase")) {
       std::string directory = textureDB.attribute("directory").as_string();
+      manifest.textureDirectory = directory;
 
       for (auto texture : textureDB.children("TextureEntry")) {
-        TextureResource res {
+        ManifestEntry entry;
+        entry.type = ManifestEntry::Texture;
+        entry.name = texture.attribute("name").as_string();
 #if defined(__NoctSys_UNIX__)
-          std::filesystem::path(directory + '/' + texture.text().as_string() + '.' + texture.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '/' + texture.text().as_string() + '.' + texture.attribute("type").as_string());
 #elif defined(__NoctSys_Windows__)
-          std::filesystem::path(directory + '\\' + texture.text().as_string() + '.' + texture.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '\\' + texture.text().as_string() + '.' + texture.attribute("type").as_string());
 #endif
-          std::make_shared<sf::Texture>()
-        };
-
-        if (!res.data->loadFromFile(res.path))
-          throw ResourceError(res.path, "could not locate texture resource");
-        
-        else m_textures[sf::String(texture.attribute("name").as_string())] = res;
+        manifest.entries.push_back(std::move(entry));
       }
     }
   }
 
 
-  void ResourceDatabase::readFontDatabase(pugi::xml_node& root) {
+  void ResourceDatabase::readFontDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto fontDB = root.child("FontDatabase")) {
       std::string directory = fontDB.attribute("directory").as_string();
+      manifest.fontDirectory = directory;
 
       for (auto font : fontDB.children("FontEntry")) {
-        FontResource res {
+        ManifestEntry entry;
+        entry.type = ManifestEntry::Font;
+        entry.name = font.attribute("name").as_string();
 #if defined(__NoctSys_UNIX__)
-          std::filesystem::path(directory + '/' + font.text().as_string() + '.' + font.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '/' + font.text().as_string() + '.' + font.attribute("type").as_string());
 #elif defined(__NoctSys_Windows__)
-          std::filesystem::path(directory + '\\' + font.text().as_string() + '.' + font.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '\\' + font.text().as_string() + '.' + font.attribute("type").as_string());
 #endif
-          std::make_shared<sf::Font>()
-        };
-
-        if (!res.data->openFromFile(res.path))
-          throw ResourceError(res.path, "could not locate font resource");
-        
-        else m_fonts[sf::String(font.attribute("name").as_string())] = res;
+        manifest.entries.push_back(std::move(entry));
       }
     }
   }
 
 
-  void ResourceDatabase::readSoundDatabase(pugi::xml_node& root) {
+  void ResourceDatabase::readSoundDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto soundDB = root.child("SoundDatabase")) {
       std::string directory = soundDB.attribute("directory").as_string();
+      manifest.soundDirectory = directory;
 
       for (auto sound : soundDB.children("SoundEntry")) {
-        SoundResource res {
+        ManifestEntry entry;
+        entry.type = ManifestEntry::Sound;
+        entry.name = sound.attribute("name").as_string();
 #if defined(__NoctSys_UNIX__)
-          std::filesystem::path(directory + '/' + sound.text().as_string() + '.' + sound.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '/' + sound.text().as_string() + '.' + sound.attribute("type").as_string());
 #elif defined(__NoctSys_Windows__)
-          std::filesystem::path(directory + '\\' + sound.text().as_string() + '.' + sound.attribute("type").as_string()),
+        entry.path = std::filesystem::path(directory + '\\' + sound.text().as_string() + '.' + sound.attribute("type").as_string());
 #endif
-          std::make_shared<sf::SoundBuffer>()
-        };
-
-        if (!res.data->loadFromFile(res.path))
-          throw ResourceError(res.path, "could not locate sound resource");
-        
-        else m_sounds[sf::String(sound.attribute("name").as_string())] = res;
+        manifest.entries.push_back(std::move(entry));
       }
     }
   }
 
 
-  void ResourceDatabase::readShaderDatabase(pugi::xml_node& root) {
+  void ResourceDatabase::readShaderDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto shaderDB = root.child("ShaderDatabase")) {
       std::string directory = shaderDB.attribute("directory").as_string();
+      manifest.shaderDirectory = directory;
 
       for (auto shader : shaderDB.children("ShaderEntry")) {
-        ShaderResource res;
-        res.isInline = shader.attribute("inline").as_bool();
-        res.type     = shaderTypeFromString(shader.attribute("type").as_string());
-        res.data     = std::make_shared<sf::Shader>();
+        ManifestEntry entry;
+        entry.type       = ManifestEntry::Shader;
+        entry.name       = shader.attribute("name").as_string();
+        entry.isInline   = shader.attribute("inline").as_bool();
+        entry.shaderType = shaderTypeFromString(shader.attribute("type").as_string());
 
-        if (res.isInline) {
-          res.code = shader.text().as_string();
+        if (entry.isInline)
+          entry.code = shader.text().as_string();
 
-          if (!res.data->loadFromMemory(res.code.c_str(), res.type)) {
-            std::string shaderName = shader.attribute("name").as_string();
-            throw ResourceError("couldn't load shader '" + shaderName + "'");
-          }
-          
-        } else {
+        else {
 #if defined(__NoctSys_UNIX__)
-          res.path = std::filesystem::path(directory + '/' + shader.text().as_string() + '.' + shader.attribute("type").as_string());
+          entry.path = std::filesystem::path(directory + '/' + shader.text().as_string() + '.' + shader.attribute("type").as_string());
 #elif defined(__NoctSys_Windows__)
-          res.path = std::filesystem::path(directory + '\\' + shader.text().as_string() + '.' + shader.attribute("type").as_string());
+          entry.path = std::filesystem::path(directory + '\\' + shader.text().as_string() + '.' + shader.attribute("type").as_string());
 #endif
-          if (!res.data->loadFromFile(res.path, res.type))
-            throw ResourceError(res.path, "could not locate shader resource");
-          
-          m_shaders[sf::String(shader.attribute("name").as_string())] = res;
         }
+
+        manifest.entries.push_back(std::move(entry));
       }
     }
   }
 
 
-  void ResourceDatabase::readColorDatabase(pugi::xml_node& root) {
+  void ResourceDatabase::readColorDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto colorDB = root.child("ColorDatabase")) {
       for (auto color : colorDB.children("ColorEntry")) {
         if (auto hex = color.attribute("hex")) {
           std::string hexstring = hex.as_string();
           
-          hexstring.erase(0);
+          hexstring.erase(0, 1);
 
           ColorInt    colorint  = std::stoul(hexstring, nullptr, 16);
-          m_colors[sf::String(color.attribute("name").as_string())] = colorint;
+          manifest.colors.emplace_back(color.attribute("name").as_string(), colorint);
         }
         else if (auto rgba = color.attribute("rgba")) {
           std::string                 csv = rgba.as_string();
@@ -320,27 +452,30 @@ namespace noct {
             else value += csv[i];
           }
 
-          m_colors[sf::String(color.attribute("name").as_string())] = sf::Color(v[0], v[1], v[2], v[3]).toInteger();
+          manifest.colors.emplace_back(color.attribute("name").as_string(), sf::Color(v[0], v[1], v[2], v[3]).toInteger());
         }
       }
     }
   }
 
 
-  void ResourceDatabase::readScriptDatabase(pugi::xml_node& root) {
+  void ResourceDatabase::readScriptDatabase(pugi::xml_node& root, ResourceManifest& manifest) {
     if (auto scriptDB = root.child("ScriptDatabase")) {
-      m_scriptDirectory = scriptDB.attribute("directory").as_string();
+      std::string directory = scriptDB.attribute("directory").as_string();
+      manifest.scriptDirectory = directory;
 
       for (auto script : scriptDB.children("ScriptEntry")) {
         if (auto type = script.attribute("lang")) {
-          if (type.as_string() == "noct") {
+          if (std::string(type.as_string()) == "noct") {
+            ManifestEntry entry;
+            entry.type = ManifestEntry::Script;
+            entry.name = script.attribute("name").as_string();
 #if defined(__NoctSys_UNIX__)
-             NativeScriptPtr ptr = std::make_shared<NativeScript>(m_scriptDirectory.string() + '/' + script.text().as_string() + ".noct");
-
+            entry.path = std::filesystem::path(directory + '/' + script.text().as_string() + ".noct");
 #elif defined(__NoctSys_Windows__)
-            NativeScriptPtr ptr = std::make_shared<NativeScript>(m_scriptDirectory.string() + '\\' + script.text().as_string() + ".noct");
+            entry.path = std::filesystem::path(directory + '\\' + script.text().as_string() + ".noct");
 #endif
-            m_nativeScripts[script.attribute("name").as_string()] = ptr;
+            manifest.entries.push_back(std::move(entry));
           } else {
             throw ResourceError("'" + std::string(script.attribute("lang").as_string()) + "' scripting has not been implemented");
           }
@@ -350,9 +485,369 @@ namespace noct {
   }
 
 
-  bool ResourceDatabase::loadTextureFromFile(const std::filesystem::path& path, const std::string_view& name) {
+  // drops names the map no longer has, then reassigns the rest so a
+  // reloaded entry keeps its slot
+  template<typename Map, typename T>
+  void ResourceDatabase::publish(const Map& map, HandleTable<T>& handles, SnapshotTable<HandleTable<T>>& view) {
+    for (const auto& name : handles.names()) {
+      if (map.find(sf::String(name)) == map.end())
+        handles.erase(name);
+    }
+
+    for (const auto& entry : map)
+      handles.assign(entry.first.toAnsiString(), valueOf(entry.second));
+
+    view.publish(handles);
+  }
+
+
+  // phase one decodes every file into CPU side objects spread over a pool
+  // of threads; phase two does what needs the owning thread's context,
+  // texture upload and shader compiles, and the maps are filled under the
+  // lock in one go at the end. A deferred batch only fills in the entries
+  // still pending for it, so one erased while it ran stays erased
+  void ResourceDatabase::loadManifest(const ResourceManifest& manifest, std::uint64_t batch) {
+    struct Decoded {
+      std::shared_ptr<sf::Image> image;
+      FontPtr                    font;
+      SoundBufferPtr             sound;
+      NativeScriptPtr            script;
+      std::string                code;
+      std::size_t                bytes;
+    };
+
+    const auto&                     entries = manifest.entries;
+    std::vector<Decoded>            decoded(entries.size());
+    std::vector<std::exception_ptr> errors(entries.size());
+    std::atomic<std::size_t>        next(0ul);
+    std::vector<std::thread>        workers;
+
+    auto work = [&]() {
+      for (auto i = next++; i < entries.size(); i = next++) {
+        const auto& entry = entries[i];
+        auto&       out   = decoded[i];
+
+        try {
+          switch (entry.type) {
+            case ManifestEntry::Texture:
+              out.image = std::make_shared<sf::Image>();
+
+              if (entry.data ? !out.image->loadFromMemory(entry.data, entry.size) : !out.image->loadFromFile(entry.path))
+                throw ResourceError(entry.path, "could not locate texture resource");
+
+              out.bytes = std::size_t(out.image->getSize().x) * out.image->getSize().y * 4;
+              break;
+
+            case ManifestEntry::Font:
+              out.font = std::make_shared<sf::Font>();
+
+              if (entry.data ? !out.font->openFromMemory(entry.data, entry.size) : !out.font->openFromFile(entry.path))
+                throw ResourceError(entry.path, "could not locate font resource");
+
+              out.bytes = fileBytes(entry);
+              break;
+
+            case ManifestEntry::Sound:
+              out.sound = std::make_shared<sf::SoundBuffer>();
+
+              if (entry.data ? !out.sound->loadFromMemory(entry.data, entry.size) : !out.sound->loadFromFile(entry.path))
+                throw ResourceError(entry.path, "could not locate sound resource");
+
+              out.bytes = static_cast<std::size_t>(out.sound->getSampleCount()) * sizeof(std::int16_t);
+              break;
+
+            case ManifestEntry::Shader:
+              if (entry.isInline)
+                out.code = entry.code;
+
+              else if (entry.data)
+                out.code.assign(reinterpret_cast<const char*>(entry.data), entry.size);
+
+              else {
+                std::ifstream file(entry.path, std::ios::in | std::ios::binary);
+
+                if (!file.is_open())
+                  throw ResourceError(entry.path, "could not locate shader resource");
+
+                out.code.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+              }
+              break;
+
+            case ManifestEntry::Script:
+              out.script = std::make_shared<NativeScript>(entry.path);
+              break;
+          }
+        }
+        catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+
+    auto threads = std::max<std::size_t>(1ul, std::thread::hardware_concurrency());
+
+    for (auto i = 1ul; i < std::min(threads, entries.size()); i++)
+      workers.emplace_back(work);
+
+    work();
+
+    for (auto& worker : workers)
+      worker.join();
+
+    for (const auto& error : errors) {
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    TextureMap textures;
+    ShaderMap  shaders;
+
+    for (std::size_t i = 0; i < entries.size(); i++) {
+      const auto& entry = entries[i];
+
+      if (entry.type == ManifestEntry::Texture) {
+        TextureResource res { entry.path, std::make_shared<sf::Texture>() };
+
+        if (!res.data->loadFromImage(*decoded[i].image))
+          throw ResourceError(entry.path, "could not upload texture resource");
+
+        textures[sf::String(entry.name)] = res;
+      }
+      else if (entry.type == ManifestEntry::Shader) {
+        ShaderResource res { entry.isInline, entry.shaderType, entry.code, entry.path, std::make_shared<sf::Shader>() };
+
+        if (!res.data->loadFromMemory(decoded[i].code, res.type))
+          throw ResourceError("couldn't load shader '" + entry.name + "'");
+
+        shaders[sf::String(entry.name)] = res;
+      }
+    }
+
+    std::vector<NativeScriptPtr> expired;
+    std::lock_guard<std::mutex>  lock(m_mutex);
+    std::vector<bool>            live(entries.size(), true);
+
+    if (batch) {
+      for (std::size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        auto        it    = m_pending.find({ entry.type, sf::String(entry.name) });
+
+        if (it != m_pending.end() && it->second.batch == batch)
+          continue;
+
+        live[i] = false;
+
+        if (entry.type == ManifestEntry::Texture)
+          textures.erase(sf::String(entry.name));
+
+        else if (entry.type == ManifestEntry::Shader)
+          shaders.erase(sf::String(entry.name));
+      }
+    }
+
+    const std::pair<std::filesystem::path*, const std::filesystem::path*> directories[] = {
+      { &m_textureDirectory, &manifest.textureDirectory },
+      { &m_fontDirectory,    &manifest.fontDirectory    },
+      { &m_soundDirectory,   &manifest.soundDirectory   },
+      { &m_shaderDirectory,  &manifest.shaderDirectory  },
+      { &m_scriptDirectory,  &manifest.scriptDirectory  }
+    };
+
+    for (const auto& directory : directories) {
+      if (!directory.second->empty())
+        *directory.first = *directory.second;
+    }
+
+    for (auto& texture : textures)
+      m_textures[texture.first] = std::move(texture.second);
+
+    for (auto& shader : shaders)
+      m_shaders[shader.first] = std::move(shader.second);
+
+    bool fonts   = false,
+         sounds  = false,
+         scripts = false;
+
+    for (std::size_t i = 0; i < entries.size(); i++) {
+      const auto& entry = entries[i];
+      sf::String  name(entry.name);
+
+      if (!live[i])
+        continue;
+
+      switch (entry.type) {
+        case ManifestEntry::Font:   m_fonts[name]  = { entry.path, decoded[i].font };  fonts   = true; break;
+        case ManifestEntry::Sound:  m_sounds[name] = { entry.path, decoded[i].sound }; sounds  = true; break;
+        case ManifestEntry::Script: swapNativeScript(name, decoded[i].script);         scripts = true; break;
+        default: break;
+      }
+    }
+
+    for (const auto& color : manifest.colors)
+      m_colors[sf::String(color.first)] = color.second;
+
+    if (!textures.empty())
+      publish(m_textures, m_textureHandles, m_textureView);
+
+    if (!shaders.empty())
+      publish(m_shaders, m_shaderHandles, m_shaderView);
+
+    if (fonts)
+      publish(m_fonts, m_fontHandles, m_fontView);
+
+    if (sounds)
+      publish(m_sounds, m_soundHandles, m_soundView);
+
+    if (scripts)
+      expired = expireNativeScripts();
+
+    if (!manifest.colors.empty())
+      publish(m_colors, m_colorHandles, m_colorView);
+
+    for (std::size_t i = 0; i < entries.size(); i++) {
+      const auto& entry = entries[i];
+
+      if (!live[i])
+        continue;
+
+      switch (entry.type) {
+        case ManifestEntry::Texture: recordUsage(entry, decoded[i].bytes, m_textures[sf::String(entry.name)].data); break;
+        case ManifestEntry::Font:    recordUsage(entry, decoded[i].bytes, decoded[i].font);                         break;
+        case ManifestEntry::Sound:   recordUsage(entry, decoded[i].bytes, decoded[i].sound);                        break;
+        default: break;
+      }
+    }
+
+    enforceBudgets();
+  }
+
+
+  void ResourceDatabase::registerManifest(const ResourceManifest& manifest) {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    m_textureDirectory = manifest.textureDirectory;
+    m_fontDirectory    = manifest.fontDirectory;
+    m_soundDirectory   = manifest.soundDirectory;
+    m_shaderDirectory  = manifest.shaderDirectory;
+    m_scriptDirectory  = manifest.scriptDirectory;
+
+    for (const auto& entry : manifest.entries)
+      m_pending[{ entry.type, sf::String(entry.name) }] = { entry, {}, 0ul };
+
+    for (const auto& color : manifest.colors)
+      m_colors[sf::String(color.first)] = color.second;
+
+    publish(m_colors, m_colorHandles, m_colorView);
+  }
+
+
+  // called with m_mutex held; the load is deferred so it runs on whichever
+  // thread waits first, and every other waiter blocks on that one run.
+  // Entries leave m_pending once loaded, or once failed so the error is
+  // only raised to the callers that were waiting on it; an entry erased or
+  // registered again meanwhile no longer carries the batch and is left be.
+  // The batch's directories stay empty, which loadManifest takes as keeping
+  // the ones registered, since entry paths are already resolved
+  std::shared_future<void> ResourceDatabase::startPending(const std::vector<PendingKey>& keys) {
+    ResourceManifest batch;
+    auto             id = ++m_batches;
+
+    for (const auto& key : keys)
+      batch.entries.push_back(m_pending[key].entry);
+
+    auto load = std::async(std::launch::deferred, [this, batch, keys, id]() {
+      auto drop = [this, &keys, id]() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (const auto& key : keys) {
+          auto it = m_pending.find(key);
+
+          if (it != m_pending.end() && it->second.batch == id)
+            m_pending.erase(it);
+        }
+      };
+
+      try {
+        loadManifest(batch, id);
+      }
+      catch (...) {
+        drop();
+        throw;
+      }
+
+      drop();
+    }).share();
+
+    for (const auto& key : keys) {
+      auto& pending = m_pending[key];
+
+      pending.load  = load;
+      pending.batch = id;
+    }
+
+    return load;
+  }
+
+
+  bool ResourceDatabase::awaitPending(std::unique_lock<std::mutex>& lock, ManifestEntry::Type type, const sf::String& name) {
+    auto it = m_pending.find({ type, name });
+
+    if (it == m_pending.end())
+      return false;
+
+    auto load = it->second.load.valid() ? it->second.load : startPending({ it->first });
+
+    lock.unlock();
+    load.get();
+    lock.lock();
+
+    return true;
+  }
+
+
+  void ResourceDatabase::listPending(ManifestEntry::Type type, StringVector& list) {
+    for (const auto& entry : m_pending) {
+      if (entry.first.first == type)
+        list.push_back(entry.first.second);
+    }
+  }
+
+
+  void ResourceDatabase::prefetch(const StringVector& names) {
+    static constexpr ManifestEntry::Type types[] = {
+      ManifestEntry::Texture, ManifestEntry::Font, ManifestEntry::Sound, ManifestEntry::Shader, ManifestEntry::Script
+    };
+
+    std::vector<std::shared_future<void>> loads;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      std::vector<PendingKey>     fresh;
+
+      for (const auto& name : names) {
+        for (auto type : types) {
+          auto it = m_pending.find({ type, name });
+
+          if (it == m_pending.end())
+            continue;
+
+          if (it->second.load.valid())
+            loads.push_back(it->second.load);
+
+          else fresh.push_back(it->first);
+        }
+      }
+
+      if (!fresh.empty())
+        loads.push_back(startPending(fresh));
+    }
+
+    for (auto& load : loads)
+      load.get();
+  }
+
+
+  bool ResourceDatabase::loadTextureFromFile(const std::filesystem::path& path, const std::string_view& name) {
     TextureResource res {
       path,
       std::make_shared<sf::Texture>()
@@ -361,6 +856,7 @@ namespace noct {
     sf::String setName(name.empty() ? path.stem().string() : name.data());
 
     if (res.data->loadFromFile(path.string())) {
+      std::lock_guard<std::mutex> lock(m_mutex);
       auto it = m_textures.find(setName);
 
       if (it != m_textures.end())
@@ -368,6 +864,15 @@ namespace noct {
 
       else m_textures[setName] = res;
       
+      publish(m_textures, m_textureHandles, m_textureView);
+
+      ManifestEntry entry;
+      entry.type = ManifestEntry::Texture;
+      entry.name = setName.toAnsiString();
+      entry.path = path;
+
+      recordUsage(entry, std::size_t(res.data->getSize().x) * res.data->getSize().y * 4, res.data);
+      enforceBudgets();
       return true;
     }
 
@@ -376,8 +881,6 @@ namespace noct {
 
 
   bool ResourceDatabase::loadFontFromFile(const std::filesystem::path& path, const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     FontResource res {
       path,
       std::make_shared<sf::Font>()
@@ -386,6 +889,7 @@ namespace noct {
     sf::String setName(name.empty() ? path.stem().string() : name.data());
 
     if (res.data->openFromFile(path.string())) {
+      std::lock_guard<std::mutex> lock(m_mutex);
       auto it = m_fonts.find(setName);
 
       if (it != m_fonts.end())
@@ -393,6 +897,15 @@ namespace noct {
 
       else m_fonts[setName] = res;
       
+      publish(m_fonts, m_fontHandles, m_fontView);
+
+      ManifestEntry entry;
+      entry.type = ManifestEntry::Font;
+      entry.name = setName.toAnsiString();
+      entry.path = path;
+
+      recordUsage(entry, fileBytes(entry), res.data);
+      enforceBudgets();
       return true;
     }
 
@@ -401,8 +914,6 @@ namespace noct {
 
 
   bool ResourceDatabase::loadSoundFromFile(const std::filesystem::path& path, const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     SoundResource res {
       path,
       std::make_shared<sf::SoundBuffer>()
@@ -411,6 +922,7 @@ namespace noct {
     sf::String setName(name.empty() ? path.stem().string() : name.data());
 
     if (res.data->loadFromFile(path.string())) {
+      std::lock_guard<std::mutex> lock(m_mutex);
       auto it = m_sounds.find(setName);
 
       if (it != m_sounds.end()) 
@@ -418,6 +930,15 @@ namespace noct {
       
       else m_sounds[setName] = res;
       
+      publish(m_sounds, m_soundHandles, m_soundView);
+
+      ManifestEntry entry;
+      entry.type = ManifestEntry::Sound;
+      entry.name = setName.toAnsiString();
+      entry.path = path;
+
+      recordUsage(entry, static_cast<std::size_t>(res.data->getSampleCount()) * sizeof(std::int16_t), res.data);
+      enforceBudgets();
       return true;
     }
 
@@ -426,15 +947,13 @@ namespace noct {
 
 
   bool ResourceDatabase::loadShaderFromFile(const std::filesystem::path& path, sf::Shader::Type type, const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     if (!sf::Shader::isAvailable()) 
       throw ResourceError("sf::Shader is not supported by your GPU");
 
     ShaderResource res {
       false, 
       type,
-      nullptr,
+      {},
       path,
       std::make_shared<sf::Shader>()
     };
@@ -442,6 +961,7 @@ namespace noct {
     sf::String setName(name.empty() ? path.stem().string() : name.data());
 
     if (res.data->loadFromFile(path.string(), type)) {
+      std::lock_guard<std::mutex> lock(m_mutex);
       auto it = m_shaders.find(setName);
 
       if (it != m_shaders.end())
@@ -449,6 +969,7 @@ namespace noct {
       
       else m_shaders[setName] = res;
       
+      publish(m_shaders, m_shaderHandles, m_shaderView);
       return true;
     }
 
@@ -456,24 +977,232 @@ namespace noct {
   }
 
 
+  // the module is opened before taking the lock, and a script it replaces
+  // is retired rather than closed under whoever still holds it
   bool ResourceDatabase::loadNativeScriptFromFile(const std::filesystem::path& path, const std::string_view& name) {
-    std::lock_guard<std::mutex> lock    (m_mutex);
-    NativeScriptPtr             script  (std::make_shared<NativeScript>());
-    sf::String                  setName (name.empty() ? path.stem().string() : name.data());
+    NativeScriptPtr script  (std::make_shared<NativeScript>());
+    sf::String      setName (name.empty() ? path.stem().string() : std::string(name));
     
     if (script->open(path)) {
-      auto it = m_nativeScripts.find(setName);
+      std::vector<NativeScriptPtr> expired;
+      std::lock_guard<std::mutex>  lock(m_mutex);
 
-      if (it != m_nativeScripts.end()) {
-        it->second->close();
-        it->second.swap(script);
+      swapNativeScript(setName, script);
+      expired = expireNativeScripts();
+      return true;
+    }
+
+    return false;
+  }
+
+
+  std::future<bool> ResourceDatabase::loadNativeScriptAsync(const std::filesystem::path& path, const std::string_view& name) {
+    sf::String setName(name.empty() ? path.stem().string() : std::string(name));
+
+    std::packaged_task<bool()> job([this, path, setName]() {
+      NativeScriptPtr              script(std::make_shared<NativeScript>());
+      std::vector<NativeScriptPtr> expired;
+
+      if (!script->open(path))
+        return false;
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        swapNativeScript(setName, script);
+        expired = expireNativeScripts();
       }
-      else m_nativeScripts[setName] = script;
 
       return true;
+    });
+
+    auto result = job.get_future();
+
+    {
+      std::lock_guard<std::mutex> lock(m_loaderMutex);
+
+      if (!m_loader.joinable())
+        m_loader = std::thread(&ResourceDatabase::runLoader, this);
+
+      m_loaderJobs.push_back(std::move(job));
     }
 
-    return false;
+    m_loaderWake.notify_one();
+    return result;
+  }
+
+
+  // expired modules are dlclosed after the lock is dropped
+  void ResourceDatabase::collectNativeScripts() {
+    std::vector<NativeScriptPtr> expired;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    expired = expireNativeScripts();
+  }
+
+
+  void ResourceDatabase::swapNativeScript(const sf::String& name, const NativeScriptPtr& script) {
+    auto it = m_nativeScripts.find(name);
+
+    if (it != m_nativeScripts.end()) {
+      m_retiredScripts.push_back({ it->second, std::chrono::steady_clock::now() });
+      it->second = script;
+    }
+    else m_nativeScripts[name] = script;
+
+    publish(m_nativeScripts, m_scriptHandles, m_scriptView);
+  }
+
+
+  std::vector<NativeScriptPtr> ResourceDatabase::expireNativeScripts() {
+    std::vector<NativeScriptPtr> expired;
+    auto                         now = std::chrono::steady_clock::now();
+
+    for (auto it = m_retiredScripts.begin(); it != m_retiredScripts.end();) {
+      if (it->script.use_count() == 1 && now - it->since >= NATIVE_SCRIPT_GRACE) {
+        expired.push_back(std::move(it->script));
+        it = m_retiredScripts.erase(it);
+      }
+      else ++it;
+    }
+
+    return expired;
+  }
+
+
+  // dlopen serialises on the loader lock anyway, so one thread is enough
+  void ResourceDatabase::runLoader() {
+    for (;;) {
+      std::packaged_task<bool()> job;
+
+      {
+        std::unique_lock<std::mutex> lock(m_loaderMutex);
+        m_loaderWake.wait(lock, [this]() { return m_loaderStop || !m_loaderJobs.empty(); });
+
+        if (m_loaderJobs.empty())
+          return;
+
+        job = std::move(m_loaderJobs.front());
+        m_loaderJobs.pop_front();
+      }
+
+      job();
+    }
+  }
+
+
+  void ResourceDatabase::setBudget(ManifestEntry::Type type, std::size_t bytes) {
+    if (type != ManifestEntry::Texture && type != ManifestEntry::Font && type != ManifestEntry::Sound)
+      throw ResourceError("only textures, fonts and sounds have memory budgets");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgets[type] = bytes;
+    enforceBudgets();
+  }
+
+
+  std::size_t ResourceDatabase::getBudget(ManifestEntry::Type type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgets[type];
+  }
+
+
+  std::size_t ResourceDatabase::getUsage(ManifestEntry::Type type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t                 used = 0ul;
+
+    for (const auto& usage : m_usage) {
+      if (usage.first.first == type)
+        used += usage.second.bytes;
+    }
+
+    return used;
+  }
+
+
+  void ResourceDatabase::trimResources() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tick++;
+    enforceBudgets();
+  }
+
+
+  // called with m_mutex held, after the entry's handle table is published
+  void ResourceDatabase::recordUsage(const ManifestEntry& entry, std::size_t bytes, const std::shared_ptr<const void>& data) {
+    std::shared_ptr<std::atomic<std::uint64_t>> used;
+
+    switch (entry.type) {
+      case ManifestEntry::Texture: used = m_textureHandles.usage(entry.name); break;
+      case ManifestEntry::Font:    used = m_fontHandles.usage(entry.name);    break;
+      case ManifestEntry::Sound:   used = m_soundHandles.usage(entry.name);   break;
+      default: return;
+    }
+
+    if (!used)
+      return;
+
+    used->store(m_tick.load());
+    m_usage[{ entry.type, sf::String(entry.name) }] = { entry, bytes, data, used };
+  }
+
+
+  // called with m_mutex held; evicted entries go back to the pending table
+  // so the lazy path reloads them, and keep their handle slot
+  void ResourceDatabase::enforceBudgets() {
+    struct Idle {
+      std::uint64_t last;
+      PendingKey    key;
+    };
+
+    std::array<std::size_t, 5> used    {};
+    std::array<bool, 5>        evicted {};
+    std::vector<Idle>          idle;
+    auto                       now = m_tick.load();
+
+    for (const auto& usage : m_usage)
+      used[usage.first.first] += usage.second.bytes;
+
+    for (const auto& usage : m_usage) {
+      auto type = usage.first.first;
+      auto last = usage.second.used->load(std::memory_order_relaxed);
+
+      if (m_budgets[type] && used[type] > m_budgets[type] && last < now &&
+          usage.second.data.use_count() <= RESOURCE_INTERNAL_OWNERS)
+        idle.push_back({ last, usage.first });
+    }
+
+    std::sort(idle.begin(), idle.end(), [](const Idle& a, const Idle& b) {
+      return a.last < b.last;
+    });
+
+    for (const auto& entry : idle) {
+      auto type  = entry.key.first;
+      auto usage = m_usage.find(entry.key);
+
+      if (used[type] <= m_budgets[type])
+        continue;
+
+      used[type] -= usage->second.bytes;
+      evicted[type] = true;
+
+      switch (type) {
+        case ManifestEntry::Texture: m_textures[entry.key.second].data.reset(); break;
+        case ManifestEntry::Font:    m_fonts[entry.key.second].data.reset();    break;
+        case ManifestEntry::Sound:   m_sounds[entry.key.second].data.reset();   break;
+        default: break;
+      }
+
+      m_pending[entry.key] = { usage->second.entry, {}, 0ul };
+      m_usage.erase(usage);
+    }
+
+    if (evicted[ManifestEntry::Texture])
+      publish(m_textures, m_textureHandles, m_textureView);
+
+    if (evicted[ManifestEntry::Font])
+      publish(m_fonts, m_fontHandles, m_fontView);
+
+    if (evicted[ManifestEntry::Sound])
+      publish(m_sounds, m_soundHandles, m_soundView);
   }
 
 
@@ -486,6 +1215,8 @@ namespace noct {
       it->second = color.toInteger();
     
     else m_colors[name.data()] = color.toInteger();
+
+    publish(m_colors, m_colorHandles, m_colorView);
   }
 
 
@@ -495,9 +1226,21 @@ namespace noct {
 
 
   TexturePtr ResourceDatabase::findTexture(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto tick  = m_tick.load(std::memory_order_relaxed);
+    auto found = m_textureView.read([&](const HandleTable<TexturePtr>& table) {
+      auto data = table.use(name, tick);
+      return data ? *data : TexturePtr();
+    });
+
+    if (found)
+      return found;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto it = m_textures.find(name.data());
 
+    if ((it == m_textures.end() || !it->second.data) && awaitPending(lock, ManifestEntry::Texture, name.data()))
+      it = m_textures.find(name.data());
+
     if (it != m_textures.end())
       return it->second.data;
     
@@ -505,9 +1248,21 @@ namespace noct {
   }
 
   FontPtr ResourceDatabase::findFont(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto tick  = m_tick.load(std::memory_order_relaxed);
+    auto found = m_fontView.read([&](const HandleTable<FontPtr>& table) {
+      auto data = table.use(name, tick);
+      return data ? *data : FontPtr();
+    });
+
+    if (found)
+      return found;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto it = m_fonts.find(name.data());
 
+    if ((it == m_fonts.end() || !it->second.data) && awaitPending(lock, ManifestEntry::Font, name.data()))
+      it = m_fonts.find(name.data());
+
     if (it != m_fonts.end())
       return it->second.data;
     
@@ -516,9 +1271,21 @@ namespace noct {
 
 
   SoundBufferPtr ResourceDatabase::findSound(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto tick  = m_tick.load(std::memory_order_relaxed);
+    auto found = m_soundView.read([&](const HandleTable<SoundBufferPtr>& table) {
+      auto data = table.use(name, tick);
+      return data ? *data : SoundBufferPtr();
+    });
+
+    if (found)
+      return found;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto it = m_sounds.find(name.data());
 
+    if ((it == m_sounds.end() || !it->second.data) && awaitPending(lock, ManifestEntry::Sound, name.data()))
+      it = m_sounds.find(name.data());
+
     if (it != m_sounds.end())
       return it->second.data;
     
@@ -527,9 +1294,20 @@ namespace noct {
 
 
   ShaderPtr ResourceDatabase::findShader(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_shaderView.read([&](const HandleTable<ShaderPtr>& table) {
+      auto data = table.find(name);
+      return data ? *data : ShaderPtr();
+    });
+
+    if (found)
+      return found;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto it = m_shaders.find(name.data());
 
+    if (it == m_shaders.end() && awaitPending(lock, ManifestEntry::Shader, name.data()))
+      it = m_shaders.find(name.data());
+
     if (it != m_shaders.end())
       return it->second.data;
     
@@ -538,70 +1316,255 @@ namespace noct {
 
 
   MaybeColor ResourceDatabase::findColor(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_colors.find(name.data());
-
-    if (it != m_colors.end())
-      return std::make_optional<sf::Color>(it->second);
-    
-    return {};
+    return m_colorView.read([&](const HandleTable<ColorInt>& table) {
+      auto data = table.find(name);
+      return data ? std::make_optional<sf::Color>(*data) : MaybeColor();
+    });
   }
 
 
   NativeScriptPtr ResourceDatabase::findNativeScript(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_scriptView.read([&](const HandleTable<NativeScriptPtr>& table) {
+      auto data = table.find(name);
+      return data ? *data : NativeScriptPtr();
+    });
+
+    if (found)
+      return found;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto it = m_nativeScripts.find(name.data());
 
+    if (it == m_nativeScripts.end() && awaitPending(lock, ManifestEntry::Script, name.data()))
+      it = m_nativeScripts.find(name.data());
+
     if (it != m_nativeScripts.end())
       return it->second;
+
+    return {};
+  }
+
+
+  TextureHandle ResourceDatabase::resolveTexture(const std::string_view& name) {
+    auto resolve = [&](const HandleTable<TexturePtr>& table) {
+      return table.resolve(name);
+    };
+
+    auto handle = m_textureView.read(resolve);
+
+    if (!handle && findTexture(name))
+      handle = m_textureView.read(resolve);
+
+    return handle;
+  }
+
+
+  FontHandle ResourceDatabase::resolveFont(const std::string_view& name) {
+    auto resolve = [&](const HandleTable<FontPtr>& table) {
+      return table.resolve(name);
+    };
+
+    auto handle = m_fontView.read(resolve);
+
+    if (!handle && findFont(name))
+      handle = m_fontView.read(resolve);
+
+    return handle;
+  }
+
+
+  SoundHandle ResourceDatabase::resolveSound(const std::string_view& name) {
+    auto resolve = [&](const HandleTable<SoundBufferPtr>& table) {
+      return table.resolve(name);
+    };
+
+    auto handle = m_soundView.read(resolve);
+
+    if (!handle && findSound(name))
+      handle = m_soundView.read(resolve);
+
+    return handle;
+  }
+
+
+  ShaderHandle ResourceDatabase::resolveShader(const std::string_view& name) {
+    auto resolve = [&](const HandleTable<ShaderPtr>& table) {
+      return table.resolve(name);
+    };
+
+    auto handle = m_shaderView.read(resolve);
+
+    if (!handle && findShader(name))
+      handle = m_shaderView.read(resolve);
+
+    return handle;
+  }
+
+
+  ColorHandle ResourceDatabase::resolveColor(const std::string_view& name) {
+    return m_colorView.read([&](const HandleTable<ColorInt>& table) {
+      return table.resolve(name);
+    });
+  }
+
+
+  NativeScriptHandle ResourceDatabase::resolveNativeScript(const std::string_view& name) {
+    auto resolve = [&](const HandleTable<NativeScriptPtr>& table) {
+      return table.resolve(name);
+    };
+
+    auto handle = m_scriptView.read(resolve);
+
+    if (!handle && findNativeScript(name))
+      handle = m_scriptView.read(resolve);
+
+    return handle;
+  }
+
+
+  // an evicted entry keeps its slot with no data, and reloads by name
+  TexturePtr ResourceDatabase::findTexture(TextureHandle handle) {
+    auto        tick = m_tick.load(std::memory_order_relaxed);
+    std::string name;
+    auto        found = m_textureView.read([&](const HandleTable<TexturePtr>& table) {
+      auto data = table.use(handle, tick);
+
+      if (data && !*data)
+        name = table.nameOf(handle);
+
+      return data ? *data : TexturePtr();
+    });
+
+    if (found || name.empty())
+      return found;
+
+    return findTexture(name);
+  }
+
+
+  // an evicted entry keeps its slot with no data, and reloads by name
+  FontPtr ResourceDatabase::findFont(FontHandle handle) {
+    auto        tick = m_tick.load(std::memory_order_relaxed);
+    std::string name;
+    auto        found = m_fontView.read([&](const HandleTable<FontPtr>& table) {
+      auto data = table.use(handle, tick);
+
+      if (data && !*data)
+        name = table.nameOf(handle);
+
+      return data ? *data : FontPtr();
+    });
+
+    if (found || name.empty())
+      return found;
+
+    return findFont(name);
+  }
+
+
+  // an evicted entry keeps its slot with no data, and reloads by name
+  SoundBufferPtr ResourceDatabase::findSound(SoundHandle handle) {
+    auto        tick = m_tick.load(std::memory_order_relaxed);
+    std::string name;
+    auto        found = m_soundView.read([&](const HandleTable<SoundBufferPtr>& table) {
+      auto data = table.use(handle, tick);
+
+      if (data && !*data)
+        name = table.nameOf(handle);
+
+      return data ? *data : SoundBufferPtr();
+    });
+
+    if (found || name.empty())
+      return found;
+
+    return findSound(name);
+  }
+
+
+  ShaderPtr ResourceDatabase::findShader(ShaderHandle handle) {
+    return m_shaderView.read([&](const HandleTable<ShaderPtr>& table) {
+      auto data = table.get(handle);
+      return data ? *data : ShaderPtr();
+    });
+  }
+
+
+  MaybeColor ResourceDatabase::findColor(ColorHandle handle) {
+    return m_colorView.read([&](const HandleTable<ColorInt>& table) {
+      auto data = table.get(handle);
+      return data ? std::make_optional<sf::Color>(*data) : MaybeColor();
+    });
+  }
+
+
+  NativeScriptPtr ResourceDatabase::findNativeScript(NativeScriptHandle handle) {
+    return m_scriptView.read([&](const HandleTable<NativeScriptPtr>& table) {
+      auto data = table.get(handle);
+      return data ? *data : NativeScriptPtr();
+    });
   }
 
 
   bool ResourceDatabase::eraseTexture(const std::string_view& name) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool pending = m_pending.erase({ ManifestEntry::Texture, name.data() }) > 0;
+
+    m_usage.erase({ ManifestEntry::Texture, name.data() });
  
     if (m_textures.find(name.data()) != m_textures.end()) {
       m_textures.erase(name.data());
+      publish(m_textures, m_textureHandles, m_textureView);
       return true;
     }
 
-    return false;
+    return pending;
   }
 
 
   bool ResourceDatabase::eraseFont(const std::string_view& name) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool pending = m_pending.erase({ ManifestEntry::Font, name.data() }) > 0;
+
+    m_usage.erase({ ManifestEntry::Font, name.data() });
  
     if (m_fonts.find(name.data()) != m_fonts.end()) {
       m_fonts.erase(name.data());
+      publish(m_fonts, m_fontHandles, m_fontView);
       return true;
     }
 
-    return false;
+    return pending;
   }
 
 
   bool ResourceDatabase::eraseSound(const std::string_view& name) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool pending = m_pending.erase({ ManifestEntry::Sound, name.data() }) > 0;
+
+    m_usage.erase({ ManifestEntry::Sound, name.data() });
  
     if (m_sounds.find(name.data()) != m_sounds.end()) {
       m_sounds.erase(name.data());
+      publish(m_sounds, m_soundHandles, m_soundView);
       return true;
     }
 
-    return false;
+    return pending;
   }
 
 
   bool ResourceDatabase::eraseShader(const std::string_view& name) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    bool pending = m_pending.erase({ ManifestEntry::Shader, name.data() }) > 0;
  
     if (m_shaders.find(name.data()) != m_shaders.end()) {
       m_shaders.erase(name.data());
+      publish(m_shaders, m_shaderHandles, m_shaderView);
       return true;
     }
 
-    return false;
+    return pending;
   }
 
 
@@ -610,6 +1573,7 @@ namespace noct {
  
     if (m_colors.find(name.data()) != m_colors.end()) {
       m_colors.erase(name.data());
+      publish(m_colors, m_colorHandles, m_colorView);
       return true;
     }
 
@@ -618,14 +1582,21 @@ namespace noct {
 
 
   bool ResourceDatabase::eraseNativeScript(const std::string_view& name) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<NativeScriptPtr> expired;
+    std::lock_guard<std::mutex>  lock(m_mutex);
+    bool pending = m_pending.erase({ ManifestEntry::Script, name.data() }) > 0;
 
-    if (m_nativeScripts.find(name.data()) != m_nativeScripts.end()) {
-      m_nativeScripts.erase(name.data());
+    auto it = m_nativeScripts.find(name.data());
+
+    if (it != m_nativeScripts.end()) {
+      m_retiredScripts.push_back({ it->second, std::chrono::steady_clock::now() });
+      m_nativeScripts.erase(it);
+      publish(m_nativeScripts, m_scriptHandles, m_scriptView);
+      expired = expireNativeScripts();
       return true;
     }
 
-    return false;
+    return pending;
   }
 
 
@@ -633,9 +1604,12 @@ namespace noct {
     std::lock_guard<std::mutex> lock(m_mutex);
     StringVector list;
 
-    for (const auto& entry : m_textures)
-      list.push_back(entry.first);
+    for (const auto& entry : m_textures) {
+      if (entry.second.data)
+        list.push_back(entry.first);
+    }
     
+    listPending(ManifestEntry::Texture, list);
     return list;
   }
 
@@ -644,9 +1618,12 @@ namespace noct {
     std::lock_guard<std::mutex> lock(m_mutex);
     StringVector list;
 
-    for (const auto& entry : m_fonts)
-      list.push_back(entry.first);
+    for (const auto& entry : m_fonts) {
+      if (entry.second.data)
+        list.push_back(entry.first);
+    }
     
+    listPending(ManifestEntry::Font, list);
     return list;
   }
 
@@ -655,9 +1632,12 @@ namespace noct {
     std::lock_guard<std::mutex> lock(m_mutex);
     StringVector list;
 
-    for (const auto& entry : m_sounds)
-      list.push_back(entry.first);
+    for (const auto& entry : m_sounds) {
+      if (entry.second.data)
+        list.push_back(entry.first);
+    }
     
+    listPending(ManifestEntry::Sound, list);
     return list;
   }
 
@@ -669,6 +1649,7 @@ namespace noct {
     for (const auto& entry : m_shaders)
       list.push_back(entry.first);
     
+    listPending(ManifestEntry::Shader, list);
     return list;
   }
 
@@ -691,6 +1672,7 @@ namespace noct {
     for (const auto& entry : m_nativeScripts) 
       list.push_back(entry.first);
     
+    listPending(ManifestEntry::Script, list);
     return list;
   }
 
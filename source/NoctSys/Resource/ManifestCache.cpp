@@ -0,0 +1,313 @@
+/* ManifestCache.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/ManifestCache.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace noct {
+  namespace {
+    constexpr char          CACHE_MAGIC[4] = { 'N', 'M', 'F', 'C' };
+    constexpr std::uint64_t FNV_OFFSET     = 0xcbf29ce484222325ull;
+
+    std::uint64_t fnv1a(const char* data, std::size_t size, std::uint64_t h) {
+      for (std::size_t i = 0; i < size; i++)
+        h = (h ^ static_cast<std::uint8_t>(data[i])) * 0x100000001b3ull;
+
+      return h;
+    }
+
+    bool fileTimes(const std::filesystem::path& path, std::uint64_t& mtime, std::uint64_t& size) {
+      std::error_code code;
+      auto            time = std::filesystem::last_write_time(path, code);
+
+      if (code)
+        return false;
+
+      size = std::filesystem::file_size(path, code);
+
+      if (code)
+        return false;
+
+      mtime = static_cast<std::uint64_t>(time.time_since_epoch().count());
+      return true;
+    }
+  }
+
+
+  ManifestCache::ManifestCache()
+    : m_file(), m_header(nullptr), m_colors(nullptr), m_records(nullptr), m_strings(nullptr)
+  {}
+
+
+  std::filesystem::path ManifestCache::pathFor(const std::filesystem::path& xml_path) {
+    auto path = xml_path;
+    path += ".nmc";
+    return path;
+  }
+
+
+  // read rather than mapped, since the XML is the file someone edits and a
+  // truncation under a mapping faults; one that changes size while it is
+  // hashed gets no stamp
+  bool ManifestCache::stamp(const std::filesystem::path& xml_path, ManifestStamp& out) {
+    std::ifstream     xml(xml_path, std::ios::in | std::ios::binary);
+    std::vector<char> buffer(1ul << 16);
+    std::uint64_t     read = 0;
+
+    if (!fileTimes(xml_path, out.mtime, out.size) || !xml.is_open())
+      return false;
+
+    out.hash = FNV_OFFSET;
+
+    while (xml.read(buffer.data(), buffer.size()) || xml.gcount()) {
+      auto n = static_cast<std::size_t>(xml.gcount());
+
+      out.hash = fnv1a(buffer.data(), n, out.hash);
+      read    += n;
+    }
+
+    return read == out.size;
+  }
+
+
+  // written to a temporary beside the cache and renamed over it, so a
+  // reader never maps half a file
+  bool ManifestCache::write(const std::filesystem::path& cache_path, const ManifestStamp& stamp,
+                            const ResourceManifest& manifest, std::string& error) {
+    std::string                 strings;
+    std::vector<ManifestColor>  colors;
+    std::vector<ManifestRecord> records;
+
+    auto add = [&](const std::string& str) {
+      ManifestString out { static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(str.size()) };
+      strings += str;
+      return out;
+    };
+
+    ManifestCacheHeader header;
+    std::memset(&header, 0, sizeof header);
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+
+    const std::filesystem::path* directories[5] = {
+      &manifest.textureDirectory, &manifest.fontDirectory, &manifest.soundDirectory,
+      &manifest.shaderDirectory,  &manifest.scriptDirectory
+    };
+
+    for (auto i = 0; i < 5; i++)
+      header.directories[i] = add(directories[i]->string());
+
+    for (const auto& color : manifest.colors)
+      colors.push_back({ add(color.first), static_cast<std::uint64_t>(color.second) });
+
+    for (const auto& entry : manifest.entries) {
+      ManifestRecord record;
+      std::memset(&record, 0, sizeof record);
+
+      record.name       = add(entry.name);
+      record.path       = add(entry.path.string());
+      record.code       = add(entry.code);
+      record.type       = static_cast<std::uint8_t>(entry.type);
+      record.shaderType = static_cast<std::uint8_t>(entry.shaderType);
+      record.isInline   = entry.isInline;
+
+      records.push_back(record);
+    }
+
+    header.version       = MANIFEST_CACHE_VERSION;
+    header.count         = static_cast<std::uint32_t>(records.size());
+    header.colors        = static_cast<std::uint32_t>(colors.size());
+    header.stamp         = stamp;
+    header.stringsOffset = sizeof header + colors.size() * sizeof(ManifestColor) + records.size() * sizeof(ManifestRecord);
+    header.stringsSize   = strings.size();
+
+    auto temp = cache_path;
+    temp += ".tmp";
+
+    {
+      std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+
+      if (!file.is_open()) {
+        error = "'" + temp.string() + "': cannot open for writing";
+        return false;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof header);
+      file.write(reinterpret_cast<const char*>(colors.data()), colors.size() * sizeof(ManifestColor));
+      file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ManifestRecord));
+      file.write(strings.data(), strings.size());
+
+      if (!file.good()) {
+        error = "'" + temp.string() + "': write failed";
+        return false;
+      }
+    }
+
+    std::error_code code;
+    std::filesystem::rename(temp, cache_path, code);
+
+    if (code) {
+      error = "'" + cache_path.string() + "': " + code.message();
+      std::filesystem::remove(temp, code);
+      return false;
+    }
+
+    return true;
+  }
+
+
+  bool ManifestCache::open(const std::filesystem::path& cache_path, const std::filesystem::path& xml_path) {
+    close();
+
+    std::uint64_t mtime, size;
+
+    if (!fileTimes(xml_path, mtime, size) || !m_file.open(cache_path))
+      return false;
+
+    auto  length = static_cast<std::uint64_t>(m_file.size());
+    auto* base   = m_file.data();
+    auto  header = reinterpret_cast<const ManifestCacheHeader*>(base);
+
+    auto fail = [this]() {
+      close();
+      return false;
+    };
+
+    if (length < sizeof(ManifestCacheHeader) || std::memcmp(header->magic, CACHE_MAGIC, 4) ||
+        header->version != MANIFEST_CACHE_VERSION)
+      return fail();
+
+    if (header->stamp.mtime != mtime || header->stamp.size != size)
+      return fail();
+
+    auto tables = sizeof(ManifestCacheHeader) + std::uint64_t(header->colors) * sizeof(ManifestColor)
+                                              + std::uint64_t(header->count)  * sizeof(ManifestRecord);
+
+    if (tables > length || header->stringsOffset != tables || header->stringsSize > length - tables)
+      return fail();
+
+    auto fits = [&](ManifestString str) {
+      return std::uint64_t(str.offset) + str.length <= header->stringsSize;
+    };
+
+    auto colors  = reinterpret_cast<const ManifestColor*>(base + sizeof(ManifestCacheHeader));
+    auto records = reinterpret_cast<const ManifestRecord*>(colors + header->colors);
+
+    for (const auto& dir : header->directories) {
+      if (!fits(dir))
+        return fail();
+    }
+
+    for (std::uint32_t i = 0; i < header->colors; i++) {
+      if (!fits(colors[i].name))
+        return fail();
+    }
+
+    for (std::uint32_t i = 0; i < header->count; i++) {
+      const auto& record = records[i];
+
+      if (!fits(record.name) || !fits(record.path) || !fits(record.code) || record.type > ManifestEntry::Script)
+        return fail();
+    }
+
+    ManifestStamp current;
+
+    if (!stamp(xml_path, current) || current.hash != header->stamp.hash)
+      return fail();
+
+    m_header  = header;
+    m_colors  = colors;
+    m_records = records;
+    m_strings = reinterpret_cast<const char*>(base + header->stringsOffset);
+
+    return true;
+  }
+
+
+  void ManifestCache::close() {
+    m_file.close();
+    m_header  = nullptr;
+    m_colors  = nullptr;
+    m_records = nullptr;
+    m_strings = nullptr;
+  }
+
+
+  bool ManifestCache::isOpen() const {
+    return m_header;
+  }
+
+
+  std::size_t ManifestCache::count() const {
+    return m_header ? m_header->count : 0ul;
+  }
+
+
+  const ManifestRecord* ManifestCache::records() const {
+    return m_records;
+  }
+
+
+  std::size_t ManifestCache::colorCount() const {
+    return m_header ? m_header->colors : 0ul;
+  }
+
+
+  const ManifestColor* ManifestCache::colors() const {
+    return m_colors;
+  }
+
+
+  std::string_view ManifestCache::string(ManifestString str) const {
+    return { m_strings + str.offset, str.length };
+  }
+
+
+  // each string is copied once, straight from the mapping into the entry
+  // that carries it. Handing loadManifest views instead would only move the
+  // copy: the database keeps every one of these strings, names as map keys,
+  // paths and shader source on the resources, whole entries while pending,
+  // and it must not outlive the mapping through them
+  ResourceManifest ManifestCache::manifest() const {
+    ResourceManifest manifest;
+
+    if (!m_header)
+      return manifest;
+
+    std::filesystem::path* directories[5] = {
+      &manifest.textureDirectory, &manifest.fontDirectory, &manifest.soundDirectory,
+      &manifest.shaderDirectory,  &manifest.scriptDirectory
+    };
+
+    for (auto i = 0; i < 5; i++)
+      directories[i]->assign(string(m_header->directories[i]));
+
+    for (std::size_t i = 0; i < colorCount(); i++)
+      manifest.colors.emplace_back(std::string(string(m_colors[i].name)), static_cast<ColorInt>(m_colors[i].value));
+
+    manifest.entries.reserve(count());
+
+    for (std::size_t i = 0; i < count(); i++) {
+      const auto&   record = m_records[i];
+      ManifestEntry entry;
+
+      entry.type       = static_cast<ManifestEntry::Type>(record.type);
+      entry.shaderType = static_cast<sf::Shader::Type>(record.shaderType);
+      entry.isInline   = record.isInline;
+      entry.name.assign(string(record.name));
+      entry.path.assign(string(record.path));
+
+      if (record.isInline)
+        entry.code.assign(string(record.code));
+
+      manifest.entries.push_back(std::move(entry));
+    }
+
+    return manifest;
+  }
+}
\ No newline at end of file
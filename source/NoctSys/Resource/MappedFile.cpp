@@ -0,0 +1,172 @@
+/* MappedFile.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/MappedFile.hpp>
+#include <NoctSys/Exception/ResourceError.hpp>
+
+#if defined(__NoctSys_UNIX__)
+  #include <cerrno>
+  #include <cstring>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+
+#elif defined(__NoctSys_Windows__)
+  #include <windows.h>
+#endif
+
+namespace noct {
+  MappedFile::MappedFile()
+    : m_path(), m_data(nullptr), m_size(0ul), m_error(), m_open(false), m_copyOnWrite(false)
+#if defined(__NoctSys_Windows__)
+    , m_file(nullptr), m_mapping(nullptr)
+#endif
+  {}
+
+
+  MappedFile::MappedFile(const std::filesystem::path& path, bool copyOnWrite)
+    : MappedFile()
+  {
+    if (!open(path, copyOnWrite))
+      throw ResourceError(path, m_error);
+  }
+
+
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+
+  // maps the whole file read only; an empty file opens with no data. A copy
+  // on write mapping can be written through mutableData without touching
+  // the file, and only the pages written to stop being shared
+  bool MappedFile::open(const std::filesystem::path& path, bool copyOnWrite) {
+    close();
+    m_path = path;
+
+#if defined(__NoctSys_UNIX__)
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+      m_error = std::strerror(errno);
+      return false;
+    }
+
+    struct stat info;
+
+    if (::fstat(fd, &info)) {
+      m_error = std::strerror(errno);
+      ::close(fd);
+      return false;
+    }
+
+    m_size = std::size_t(info.st_size);
+
+    if (m_size) {
+      int   prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+      void* map  = ::mmap(nullptr, m_size, prot, MAP_PRIVATE, fd, 0);
+
+      if (map == MAP_FAILED) {
+        m_error = std::strerror(errno);
+        m_size  = 0ul;
+        ::close(fd);
+        return false;
+      }
+
+      m_data = static_cast<std::uint8_t*>(map);
+    }
+
+    ::close(fd);
+
+#elif defined(__NoctSys_Windows__)
+    m_file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (m_file == INVALID_HANDLE_VALUE) {
+      m_file  = nullptr;
+      m_error = "code " + std::to_string(::GetLastError());
+      return false;
+    }
+
+    LARGE_INTEGER size;
+    ::GetFileSizeEx(m_file, &size);
+    m_size = std::size_t(size.QuadPart);
+
+    if (m_size) {
+      m_mapping = ::CreateFileMappingW(m_file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+
+      if (m_mapping)
+        m_data = static_cast<std::uint8_t*>(::MapViewOfFile(m_mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+
+      if (!m_data) {
+        m_error = "code " + std::to_string(::GetLastError());
+        close();
+        return false;
+      }
+    }
+#endif
+
+    m_error.clear();
+    m_open        = true;
+    m_copyOnWrite = copyOnWrite;
+    return true;
+  }
+
+
+  void MappedFile::close() {
+#if defined(__NoctSys_UNIX__)
+    if (m_data)
+      ::munmap(m_data, m_size);
+
+#elif defined(__NoctSys_Windows__)
+    if (m_data)
+      ::UnmapViewOfFile(m_data);
+
+    if (m_mapping)
+      ::CloseHandle(m_mapping);
+
+    if (m_file)
+      ::CloseHandle(m_file);
+
+    m_mapping = nullptr;
+    m_file    = nullptr;
+#endif
+
+    m_data        = nullptr;
+    m_size        = 0ul;
+    m_open        = false;
+    m_copyOnWrite = false;
+  }
+
+
+  bool MappedFile::isOpen() const {
+    return m_open;
+  }
+
+
+  const std::uint8_t* MappedFile::data() const {
+    return m_data;
+  }
+
+
+  // null unless the file was mapped copy on write
+  std::uint8_t* MappedFile::mutableData() {
+    return m_copyOnWrite ? m_data : nullptr;
+  }
+
+
+  std::size_t MappedFile::size() const {
+    return m_size;
+  }
+
+
+  const std::string& MappedFile::getError() const {
+    return m_error;
+  }
+
+
+  const std::filesystem::path& MappedFile::getFilePath() const {
+    return m_path;
+  }
+}
\ No newline at end of file
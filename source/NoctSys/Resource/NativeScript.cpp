@@ -9,11 +9,11 @@
 
 namespace noct {
   NativeScript::NativeScript() 
-    : m_handle(nullptr), m_error(), m_path()
+    : m_handle(nullptr), m_plugin(nullptr), m_error(), m_path()
   {}
 
   NativeScript::NativeScript(const std::filesystem::path& path) 
-    : m_handle(nullptr), m_error(), m_path(path)
+    : m_handle(nullptr), m_plugin(nullptr), m_error(), m_path(path)
   {
     if (!open(path))
 #if defined(__NoctSys_UNIX__)
@@ -33,42 +33,81 @@ namespace noct {
     bool ret = false;
 
 #if defined(__NoctSys_UNIX__)
-    if (path.extension().string() == "noct") {
+    if (path.extension().string() == ".noct") {
       if (std::filesystem::exists(path)) {
         m_handle = dlopen((CStr)path.c_str(), RTLD_NOW);
-        m_error  = dlerror();
 
         if (m_handle)
           ret = true;
-      }
-    } else m_error = "invalid file type: '" + path.extension().string() "'";
+
+        else m_error = dlerror();
+      } else m_error = "file not found: '" + path.string() + "'";
+    } else m_error = "invalid file type: '" + path.extension().string() + "'";
 
 #elif defined(__NoctSys_Windows__)
-    if (path.extension().string() == "noct") {
+    if (path.extension().string() == ".noct") {
       if (std::filesystem::exists(path)) {
-        m_handle = LoadLibraryA((CStr)path.c_str());
+        m_handle = LoadLibraryA((CStr)path.string().c_str());
         m_error  = GetLastError();
 
-        if (m_error == ERROR_SUCCESS);
+        if (m_handle)
           ret = true;
           
       } else m_error = ERROR_FILE_NOT_FOUND;
     } else m_error = ERROR_MOD_NOT_FOUND;
 #endif
 
-    return ret;
+    return ret && loadPlugin();
+  }
+
+
+  // the entry point is optional; a module without one is still usable
+  // through find, but one that has it must speak this ABI
+  bool NativeScript::loadPlugin() {
+    m_plugin = nullptr;
+
+#if defined(__NoctSys_UNIX__)
+    auto entry = reinterpret_cast<NoctPluginEntry>(dlsym(m_handle, NOCT_PLUGIN_ENTRY));
+    dlerror();
+
+#elif defined(__NoctSys_Windows__)
+    auto entry = reinterpret_cast<NoctPluginEntry>(GetProcAddress(m_handle, NOCT_PLUGIN_ENTRY));
+#endif
+
+    if (!entry)
+      return true;
+
+    auto* header = entry(NOCT_PLUGIN_ABI);
+
+    if (header && header->abi == NOCT_PLUGIN_ABI && header->size >= sizeof(NoctPluginHeader)) {
+      m_plugin = header;
+      return true;
+    }
+
+#if defined(__NoctSys_UNIX__)
+    m_error = "plugin ABI " + std::to_string(header ? header->abi : 0u) + ", expected " + std::to_string(NOCT_PLUGIN_ABI);
+
+#elif defined(__NoctSys_Windows__)
+    m_error = ERROR_REVISION_MISMATCH;
+#endif
+
+    close();
+    return false;
   }
 
 
   void NativeScript::close() {
     if (m_handle) {
-#if defined(__NoctSys_Unix__)
+#if defined(__NoctSys_UNIX__)
       dlclose(m_handle);
 
 #elif defined(__NoctSys_Windows__)
       FreeLibrary(m_handle);
 #endif
     }
+
+    m_handle = nullptr;
+    m_plugin = nullptr;
   }
 
 
@@ -133,6 +172,10 @@ namespace noct {
         error << "code " << m_error << ": DLL Init Failed";
         break;
 
+      case ERROR_REVISION_MISMATCH:
+        error << "code " << m_error << ": plugin ABI does not match, expected " << NOCT_PLUGIN_ABI;
+        break;
+
       default: 
         error << "code " << m_error;
 
@@ -148,18 +191,37 @@ namespace noct {
   }
 
 
+  bool NativeScript::isPlugin() {
+    return m_plugin ? true : false;
+  }
+
+
+  const NoctPluginHeader* NativeScript::getPluginHeader() {
+    return m_plugin;
+  }
+
+
+  bool NativeScript::hasCapability(std::uint32_t flags) {
+    return m_plugin && (m_plugin->flags & flags) == flags;
+  }
+
+
   LoaderHandle NativeScript::find(const std::string_view& symbol) {
-    std::string sym = symbol.data();
+    std::string sym { symbol };
     std::replace(sym.begin(), sym.end(), ' ', '_');
 
 #if defined(__NoctSys_UNIX__)
-    LoaderHandle proc = dlsym(m_handle, sym.c_str());
-    m_error = dlerror();
+    dlerror();
+
+    LoaderHandle proc  = dlsym(m_handle, sym.c_str());
+    const char*  error = dlerror();
+
+    m_error = error ? error : "";
 
 #elif defined(__NoctSys_Windows__)
     LoaderHandle proc = GetProcAddress(m_handle, (CStr)sym.c_str());
     m_error           = GetLastError();
-    m_lastSymbol      = symbol.data();
+    m_lastSymbol      = sym;
 
     if (m_error != ERROR_SUCCESS)
       return nullptr;
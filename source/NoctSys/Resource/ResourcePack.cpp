@@ -0,0 +1,373 @@
+/* ResourcePack.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/ResourcePack.hpp>
+#include <NoctSys/Exception/ResourceError.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace noct {
+  namespace {
+    constexpr char PACK_MAGIC[4] = { 'N', 'P', 'A', 'K' };
+
+    std::uint64_t align(std::uint64_t offset) {
+      return (offset + RESOURCE_PACK_ALIGNMENT - 1) & ~std::uint64_t(RESOURCE_PACK_ALIGNMENT - 1);
+    }
+  }
+
+
+  ResourcePack::ResourcePack()
+    : m_file(), m_header(nullptr), m_entries(nullptr), m_strings(nullptr), m_error()
+  {}
+
+
+  ResourcePack::ResourcePack(const std::filesystem::path& path)
+    : ResourcePack()
+  {
+    if (!open(path))
+      throw ResourceError(path, m_error);
+  }
+
+
+  // FNV-1a over the type then the name
+  std::uint64_t ResourcePack::hash(ManifestEntry::Type type, std::string_view name) {
+    std::uint64_t h = 0xcbf29ce484222325ull;
+
+    h = (h ^ static_cast<std::uint8_t>(type)) * 0x100000001b3ull;
+
+    for (auto c : name)
+      h = (h ^ static_cast<std::uint8_t>(c)) * 0x100000001b3ull;
+
+    return h;
+  }
+
+
+  // everything the index points at is bounds checked here, so lookups and
+  // manifest() can trust it
+  bool ResourcePack::open(const std::filesystem::path& path) {
+    close();
+
+    if (!m_file.open(path)) {
+      m_error = m_file.getError();
+      return false;
+    }
+
+    auto  size   = static_cast<std::uint64_t>(m_file.size());
+    auto* base   = m_file.data();
+    auto  header = reinterpret_cast<const PackHeader*>(base);
+
+    auto fail = [this](const std::string& error) {
+      m_error = error;
+      close();
+      return false;
+    };
+
+    if (size < sizeof(PackHeader) || std::memcmp(header->magic, PACK_MAGIC, 4))
+      return fail("not a resource pack");
+
+    if (header->version != RESOURCE_PACK_VERSION)
+      return fail("unsupported resource pack version " + std::to_string(header->version));
+
+    if (!header->buckets || (header->buckets & (header->buckets - 1)) || header->count > header->buckets)
+      return fail("corrupt resource pack index");
+
+    auto indexEnd = sizeof(PackHeader) + std::uint64_t(header->buckets) * sizeof(PackEntry);
+
+    if (indexEnd > size || header->stringsOffset < indexEnd || header->stringsSize > size - header->stringsOffset)
+      return fail("truncated resource pack");
+
+    auto entries = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+
+    for (std::uint32_t i = 0; i < header->buckets; i++) {
+      const auto& entry = entries[i];
+
+      if (!entry.nameLength)
+        continue;
+
+      if (std::uint64_t(entry.name) + entry.nameLength > header->stringsSize ||
+          std::uint64_t(entry.path) + entry.pathLength > header->stringsSize ||
+          entry.offset > size || entry.size > size - entry.offset ||
+          entry.type > ManifestEntry::Shader)
+        return fail("corrupt resource pack entry");
+    }
+
+    m_header  = header;
+    m_entries = entries;
+    m_strings = reinterpret_cast<const char*>(base + header->stringsOffset);
+    m_error.clear();
+
+    return true;
+  }
+
+
+  void ResourcePack::close() {
+    m_file.close();
+    m_header  = nullptr;
+    m_entries = nullptr;
+    m_strings = nullptr;
+  }
+
+
+  bool ResourcePack::isOpen() const {
+    return m_header;
+  }
+
+
+  const PackEntry* ResourcePack::find(ManifestEntry::Type type, std::string_view name) const {
+    if (!m_header)
+      return nullptr;
+
+    auto h    = hash(type, name);
+    auto mask = m_header->buckets - 1;
+    auto i    = std::uint32_t(h) & mask;
+
+    for (std::uint32_t n = 0; n < m_header->buckets; n++, i = (i + 1) & mask) {
+      const auto& entry = m_entries[i];
+
+      if (!entry.nameLength)
+        return nullptr;
+
+      if (entry.hash == h && entry.type == type && this->name(entry) == name)
+        return &entry;
+    }
+
+    return nullptr;
+  }
+
+
+  const std::uint8_t* ResourcePack::data(const PackEntry& entry) const {
+    return m_file.data() + entry.offset;
+  }
+
+
+  std::string_view ResourcePack::name(const PackEntry& entry) const {
+    return { m_strings + entry.name, entry.nameLength };
+  }
+
+
+  std::string_view ResourcePack::path(const PackEntry& entry) const {
+    return { m_strings + entry.path, entry.pathLength };
+  }
+
+
+  std::size_t ResourcePack::count() const {
+    return m_header ? m_header->count : 0ul;
+  }
+
+
+  ResourceManifest ResourcePack::manifest() const {
+    ResourceManifest manifest;
+
+    if (!m_header)
+      return manifest;
+
+    manifest.entries.reserve(m_header->count);
+
+    for (std::uint32_t i = 0; i < m_header->buckets; i++) {
+      const auto& entry = m_entries[i];
+
+      if (!entry.nameLength)
+        continue;
+
+      ManifestEntry out;
+      out.type       = static_cast<ManifestEntry::Type>(entry.type);
+      out.name       = std::string(name(entry));
+      out.path       = std::filesystem::path(std::string(path(entry)));
+      out.shaderType = static_cast<sf::Shader::Type>(entry.shaderType);
+      out.data       = data(entry);
+      out.size       = static_cast<std::size_t>(entry.size);
+
+      if (entry.flags & PACK_ENTRY_INLINE) {
+        out.isInline = true;
+        out.code.assign(reinterpret_cast<const char*>(out.data), out.size);
+      }
+
+      manifest.entries.push_back(std::move(out));
+    }
+
+    return manifest;
+  }
+
+
+  const std::string& ResourcePack::getError() const {
+    return m_error;
+  }
+
+
+  const std::filesystem::path& ResourcePack::getFilePath() const {
+    return m_file.getFilePath();
+  }
+
+
+  void ResourcePackWriter::add(const ManifestEntry& entry) {
+    if (entry.type == ManifestEntry::Script)
+      throw ResourceError(entry.path, "native scripts cannot be packed");
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const ManifestEntry& other) {
+      return other.type == entry.type && other.name == entry.name;
+    });
+
+    if (it != m_entries.end())
+      *it = entry;
+
+    else m_entries.push_back(entry);
+  }
+
+
+  void ResourcePackWriter::add(const ResourceManifest& manifest) {
+    for (const auto& entry : manifest.entries) {
+      if (entry.type != ManifestEntry::Script)
+        add(entry);
+    }
+  }
+
+
+  std::size_t ResourcePackWriter::count() const {
+    return m_entries.size();
+  }
+
+
+  // sizes are taken up front so the layout is known before any blob is
+  // copied; blobs are then streamed one file at a time
+  bool ResourcePackWriter::write(const std::filesystem::path& path, std::string& error) const {
+    std::uint32_t buckets = 1u;
+
+    while (buckets < m_entries.size() * 2)
+      buckets <<= 1;
+
+    std::vector<PackEntry> index(buckets);
+    std::vector<PackEntry> placed(m_entries.size());
+    std::string            strings;
+
+    std::memset(index.data(), 0, index.size() * sizeof(PackEntry));
+
+    for (std::size_t i = 0; i < m_entries.size(); i++) {
+      const auto& entry  = m_entries[i];
+      auto&       out    = placed[i];
+      std::string source = entry.path.generic_string();
+
+      std::memset(&out, 0, sizeof out);
+
+      if (entry.isInline)
+        out.size = entry.code.size();
+
+      else {
+        std::error_code code;
+        out.size = std::filesystem::file_size(entry.path, code);
+
+        if (code) {
+          error = "'" + entry.path.string() + "': " + code.message();
+          return false;
+        }
+      }
+
+      if (entry.name.empty() || entry.name.size() > UINT32_MAX || source.size() > UINT32_MAX) {
+        error = "bad entry name '" + entry.name + "'";
+        return false;
+      }
+
+      out.hash       = ResourcePack::hash(entry.type, entry.name);
+      out.name       = static_cast<std::uint32_t>(strings.size());
+      out.nameLength = static_cast<std::uint32_t>(entry.name.size());
+      strings       += entry.name;
+      out.path       = static_cast<std::uint32_t>(strings.size());
+      out.pathLength = static_cast<std::uint32_t>(source.size());
+      strings       += source;
+      out.type       = static_cast<std::uint8_t>(entry.type);
+      out.shaderType = static_cast<std::uint8_t>(entry.shaderType);
+      out.flags      = entry.isInline ? PACK_ENTRY_INLINE : 0;
+    }
+
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, 4);
+    header.version       = RESOURCE_PACK_VERSION;
+    header.count         = static_cast<std::uint32_t>(m_entries.size());
+    header.buckets       = buckets;
+    header.stringsOffset = sizeof(PackHeader) + std::uint64_t(buckets) * sizeof(PackEntry);
+    header.stringsSize   = strings.size();
+
+    auto offset = align(header.stringsOffset + header.stringsSize);
+
+    for (auto& out : placed) {
+      out.offset = offset;
+      offset     = align(offset + out.size);
+
+      for (auto i = std::uint32_t(out.hash) & (buckets - 1);; i = (i + 1) & (buckets - 1)) {
+        if (!index[i].nameLength) {
+          index[i] = out;
+          break;
+        }
+      }
+    }
+
+    // written beside the target and renamed over it, so a reader mapping
+    // the old pack never sees a half-written one
+    auto temp = path;
+    temp += ".tmp";
+
+    auto fail = [&](const std::string& message) {
+      std::error_code code;
+      error = message;
+      std::filesystem::remove(temp, code);
+      return false;
+    };
+
+    {
+      std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+
+      if (!file.is_open()) {
+        error = "'" + temp.string() + "': cannot open for writing";
+        return false;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof header);
+      file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(PackEntry));
+      file.write(strings.data(), strings.size());
+
+      std::vector<char> buffer(1ul << 16);
+
+      for (std::size_t i = 0; i < m_entries.size(); i++) {
+        const auto& entry = m_entries[i];
+        const auto& out   = placed[i];
+
+        while (static_cast<std::uint64_t>(file.tellp()) < out.offset)
+          file.put('\0');
+
+        if (entry.isInline) {
+          file.write(entry.code.data(), entry.code.size());
+          continue;
+        }
+
+        std::ifstream blob(entry.path, std::ios::in | std::ios::binary);
+        std::uint64_t left = out.size;
+
+        while (left && blob.read(buffer.data(), std::min<std::uint64_t>(left, buffer.size()))) {
+          file.write(buffer.data(), blob.gcount());
+          left -= blob.gcount();
+        }
+
+        if (left) {
+          file.close();
+          return fail("'" + entry.path.string() + "': short read");
+        }
+      }
+
+      if (!file.good()) {
+        file.close();
+        return fail("'" + temp.string() + "': write failed");
+      }
+    }
+
+    std::error_code code;
+    std::filesystem::rename(temp, path, code);
+
+    if (code)
+      return fail("'" + path.string() + "': " + code.message());
+
+    return true;
+  }
+}
\ No newline at end of file
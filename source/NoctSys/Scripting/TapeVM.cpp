@@ -6,13 +6,20 @@
 #include <NoctSys/Exception/TapeError.hpp>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+  #define TAPE_STACK_ASSERT(x)
+#else
+  #define TAPE_STACK_ASSERT(x) assert(x)
+#endif
 
 namespace noct {
 
   TapeVM::TapeVM() 
-    : m_stack(), m_fstack(), m_dict(), m_exec(), m_mem(), m_mode(TapeVM::InputMode::Interpreting)
+    : m_stack(), m_fstack(), m_isAllocating(false), m_lazyIncludes(false), m_mode(TapeVM::InputMode::Interpreting), m_dict(), m_exec(), m_mem(), m_lazy()
   {
-#if defined(__NoctSys_Unix__) 
+#if defined(__NoctSys_UNIX__) 
     m_includeDirectories = {
       "/usr/share/NoctSys/tape/?.tape",
       "/usr/share/NoctSys/tape/?.fth",
@@ -55,29 +62,35 @@ namespace noct {
     clearStacks();
 
     for (auto& tag : m_mem) {
-      if (tag.data) 
+      if (tag.data && !tag.mapped) 
         std::free((char*)tag.data);
     }
+
+    for (auto& tag : m_retired)
+      std::free((char*)tag.data);
   }
 
   void TapeVM::addIncludeDirectory(const std::string& directory) {
     m_includeDirectories.push_back(directory);
+    m_includeIndex.forget();
   }
 
   std::string TapeVM::convertModname(std::string modname) {
 #if defined(__NoctSys_UNIX__)
     std::replace(modname.begin(), modname.end(), '.', '/');
 
-#elif defined(__NoctSys_Windows__);
+#elif defined(__NoctSys_Windows__)
     std::replace(modname.begin(), modname.end(), '.', '\\');
 #endif 
     return modname;
   }
 
   std::string TapeVM::convertDirectory(std::string directory, const std::string& modname) {
-    static const std::string re  = "?";
+    auto pos = directory.find('?');
+
+    if (pos != std::string::npos)
+      directory.replace(pos, 1, modname);
 
-    std::replace(directory.begin(), directory.end(), re, modname);
     return directory;
   }
 
@@ -101,14 +114,25 @@ namespace noct {
     if (it != m_dict.end())
       return &(it->second);
 
+    if (!m_lazy.empty()) {
+      auto lazy = m_lazy.find(std::string(word));
+
+      if (lazy != m_lazy.end())
+        return compileLazy(lazy);
+    }
+
     return nullptr;
   }
 
 
   void TapeVM::addWord(const std::string_view& word) {
-    auto        it = m_dict.find(word.data());
     std::string w{word};
 
+    if (!m_lazy.empty())
+      settleLazy(w);
+
+    auto        it = m_dict.find(w);
+
     if (it != m_dict.end())
       m_dict[w].code.clear();
     
@@ -126,6 +150,9 @@ namespace noct {
 
 
   void TapeVM::addWord(const std::string_view& name, const TapeVM::Word& token) {
+    if (!m_lazy.empty())
+      settleLazy(std::string(name));
+
     m_dict[std::string(name)] = { token };
   }
 
@@ -151,6 +178,9 @@ namespace noct {
 
 
   void TapeVM::xpush(const Word& word) {
+#if defined(NOCTSYS_TAPE_TRACE)
+    m_trace.record(reinterpret_cast<std::uintptr_t>(&word), m_exec.empty() ? 0ul : m_exec.back().ip, m_stack.size());
+#endif
     m_exec.push_back({&word, 0ul});
   }
 
@@ -160,27 +190,146 @@ namespace noct {
   }
 
 
-  void TapeVM::execute() {
+  // a word that changes the mode, like : or ; does, keeps its change;
+  // otherwise the caller's mode is put back
+  void TapeVM::execute(TapeVM::InputMode mode) {
     if (!m_exec.empty()) {
       auto lastMode = m_mode;
-      m_mode = TapeVM::InputMode::Executing;
+      m_mode = mode;
 
-      do {
-        auto& token = m_exec.back();
+      // a word that throws leaves its frames and mode behind; drop them
+      // here so the next evaluate starts from a clean tape
+#if defined(NOCTSYS_TAPE_TRACE)
+      m_executing++;
+#endif
 
-        if (token.ip >= token.word->size()) {
-          m_exec.pop_back();
-          continue;
-        }
-        else {
-          token.word->at(token.ip).func(*this);
-          token.ip++;
+      try {
+        dispatchGuarded(0ul, lastMode);
+      }
+      catch (...) {
+#if defined(NOCTSYS_TAPE_TRACE)
+        if (--m_executing == 0ul && m_traceHandler) {
+          try {
+            throw;
+          }
+          catch (TapeError& e) {
+            m_traceHandler(*this, e);
+          }
+          catch (...) {}
         }
-      } while (!m_exec.empty());
+#endif
+        m_mode = lastMode;
+        m_exec.clear();
+        throw;
+      }
+
+#if defined(NOCTSYS_TAPE_TRACE)
+      m_executing--;
+#endif
+
+      if (m_mode == mode)
+        m_mode = lastMode;
+    }
+  }
+
+
+  // runs word to completion from inside another word, leaving the frames
+  // below it alone; like execute, a mode change the word makes is kept
+  void TapeVM::call(const TapeVM::Word& word, TapeVM::InputMode mode) {
+    if (m_exec.size() >= TAPE_CALL_DEPTH)
+      throw TapeError("Call Depth Exceeded", std::to_string(m_exec.size()));
+
+    auto depth    = m_exec.size();
+    auto lastMode = m_mode;
+    m_mode = mode;
+
+    xpush(word);
+
+    try {
+      dispatchGuarded(depth, lastMode);
+    }
+    catch (...) {
+      m_mode = lastMode;
+      throw;
+    }
+
+    if (m_mode == mode)
+      m_mode = lastMode;
+  }
+
+
+  // a guard page fault jumps back here, skipping only dispatch and the
+  // faulting primitive, and is thrown on as a TapeError; call arms its own
+  // scope so the fault never skips the frames of the word that called it
+  void TapeVM::dispatchGuarded(std::size_t depth, TapeVM::InputMode lastMode) {
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+    guard::Scope scope;
+    scope.regions[0] = &m_stack.region();
+    scope.regions[1] = &m_rstack.region();
+    scope.regions[2] = &m_fstack.region();
+
+    if (sigsetjmp(scope.jump, 1))
+      fault(scope, lastMode);
 
+    guard::enter(scope);
+
+    try {
+      dispatch(depth);
+    }
+    catch (...) {
+      guard::leave(scope);
       m_mode = lastMode;
+      throw;
+    }
+
+    guard::leave(scope);
+#else
+    (void)lastMode;
+    dispatch(depth);
+#endif
+  }
+
+
+  void TapeVM::dispatch(std::size_t depth) {
+    while (m_exec.size() > depth) {
+      // words may push or pop frames, so the frame is found again by index
+      auto index = m_exec.size() - 1;
+      auto token = m_exec[index];
+
+      if (token.ip >= token.word->size())
+        m_exec.pop_back();
+
+      else {
+        token.word->at(token.ip).func(*this);
+
+        if (index < m_exec.size())
+          m_exec[index].ip++;
+      }
+    }
+  }
+
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+  void TapeVM::fault(const guard::Scope& scope, TapeVM::InputMode lastMode) {
+    std::string word = "execute";
+
+    if (!m_exec.empty()) {
+      for (const auto& entry : m_dict) {
+        if (&entry.second.code == m_exec.back().word) {
+          word = entry.first;
+          break;
+        }
+      }
     }
+
+    m_stack.recover();
+    m_rstack.recover();
+    m_fstack.recover();
+    m_mode = lastMode;
+
+    throw TapeError(scope.side == GuardedRegion::Below ? "Stack Underflow" : "Stack Overflow", word);
   }
+#endif
 
 
   std::uintptr_t TapeVM::allot(std::size_t size) {
@@ -215,6 +364,8 @@ namespace noct {
   }
 
   std::uintptr_t TapeVM::alloc(std::size_t size) {
+    m_regionsDirty = true;
+
     for (auto& tag : m_mem) {
       if (tag.free) {
         tag.size   = size;
@@ -238,13 +389,28 @@ namespace noct {
 
 
   std::uintptr_t TapeVM::realloc(std::uintptr_t data, std::size_t size) {
+    m_regionsDirty = true;
+
     auto tag = findMem(data);
 
     if (tag && !(tag->free)) {
       if (tag->pinned)
         throw TapeError("Cannot reallocate pinned data", std::to_string(data));
 
-      tag->data = (std::uintptr_t)std::realloc((char*)(tag->data), size);
+      if (tag->mapped)
+        throw TapeError("Cannot reallocate a mapped file", std::to_string(data));
+
+      if (m_holds.count(tag->data)) {
+        auto  moved = *tag;
+        auto* data  = std::malloc(size);
+
+        std::memcpy(data, (char*)(moved.data), std::min(size, moved.size));
+        retire(moved);
+
+        tag->data = (std::uintptr_t)data;
+      }
+      else tag->data = (std::uintptr_t)std::realloc((char*)(tag->data), size);
+
       tag->size = size;
 
       return tag->data;
@@ -261,11 +427,10 @@ namespace noct {
     else if (tag->pinned)
       throw TapeError("Cannot free pinned data", std::to_string(tag->data));
 
-    std::free((char*)(tag->data));
+    else if (tag->mapped)
+      throw TapeError("Cannot free a mapped file: use UNMAP-FILE", std::to_string(tag->data));
 
-    tag->data   = 0ul;
-    tag->size   = 0ul;
-    tag->free   = true;
+    retire(*tag);
   }
 
 
@@ -282,9 +447,10 @@ namespace noct {
 
   void TapeVM::setPinned(std::uintptr_t data, bool flag) {
     for (auto& tag : m_mem) {
-      if (tag.data == data)
+      if (tag.data == data) {
         tag.pinned = flag;
         return;
+      }
     }
   }
 
@@ -293,19 +459,19 @@ namespace noct {
   }
 
   std::uintptr_t& TapeVM::top() {
-    assert(!m_stack.empty());
+    TAPE_STACK_ASSERT(!m_stack.empty());
     return m_stack.back();
   }
 
 
   std::uintptr_t& TapeVM::at(std::size_t index) {
-    assert(!m_stack.empty() && index < m_stack.size());
+    TAPE_STACK_ASSERT(!m_stack.empty() && index < m_stack.size());
     return m_stack[index];
   }
 
 
   std::uintptr_t TapeVM::pop() {
-    assert(!m_stack.empty());
+    TAPE_STACK_ASSERT(!m_stack.empty());
     std::uintptr_t ret = m_stack.back();
     m_stack.pop_back();
     return ret;
@@ -322,19 +488,19 @@ namespace noct {
 
 
   std::uintptr_t& TapeVM::rtop() {
-    assert(!m_rstack.empty());
+    TAPE_STACK_ASSERT(!m_rstack.empty());
     return m_rstack.back();
   }
 
 
   std::uintptr_t& TapeVM::rat(std::size_t index) {
-    assert(!m_rstack.empty() && index < m_rstack.size());
+    TAPE_STACK_ASSERT(!m_rstack.empty() && index < m_rstack.size());
     return m_rstack[index];
   }
 
 
   std::uintptr_t TapeVM::rpop() {
-    assert(!m_rstack.empty());
+    TAPE_STACK_ASSERT(!m_rstack.empty());
     std::uintptr_t ret = m_rstack.back();
     m_rstack.pop_back();
     return ret;
@@ -351,19 +517,19 @@ namespace noct {
   }
 
   float& TapeVM::ftop() {
-    assert(!m_fstack.empty());
+    TAPE_STACK_ASSERT(!m_fstack.empty());
     return m_fstack.back();
   }
 
 
   float& TapeVM::fat(std::size_t index) {
-    assert(!m_fstack.empty() && index < m_fstack.size());
+    TAPE_STACK_ASSERT(!m_fstack.empty() && index < m_fstack.size());
     return m_fstack[index];
   }
 
 
   float TapeVM::fpop() {
-    assert(!m_fstack.empty());
+    TAPE_STACK_ASSERT(!m_fstack.empty());
     float ret = m_fstack.back();
     m_fstack.pop_back();
     return ret;
@@ -395,7 +561,7 @@ namespace noct {
     if (ch == EOF)
       return {};
 
-    for (ch = m_input.get(); ch != EOF && !std::isspace(ch); ch = m_input.get())
+    for (; ch != EOF && !std::isspace(ch); ch = m_input.get())
       output.push_back(char(ch));
     
     if (ch != EOF)
@@ -511,67 +677,98 @@ namespace noct {
 
 
   void TapeVM::processToken(const std::string& word) {
-    auto* w = findWord(word);
+    if (auto* w = findWord(word))
+      processWord(*w, word);
 
-    if (w) {
-      switch (getInputMode()) {
-        case TapeVM::InputMode::Interpreting:
-          xpush(w->code);
-          execute();
-          break;
-        
-        case TapeVM::InputMode::Compiling:
-          if (w->immediate) {
-            xpush(w->code);
-            execute();
-          }
-          else {
-            if (w->code.size() > 2)
-              compileReference(getLastDefinition(), word);
+    else if (isInteger(word))
+      processInteger(toInteger(word));
 
-            else 
-              compileInline(getLastDefinition(), w->code[0].func, w->code[0].data);
-          }
-          break;
-      }
-      return;
+    else if (isRealnum(word))
+      processRealnum(toRealnum(word));
+
+    else throw TapeError("Unknown Word", word);
+  }
+
+
+  void TapeVM::processWord(const WordTag& w, const std::string_view& word) {
+    switch (getInputMode()) {
+      case TapeVM::InputMode::Interpreting:
+        xpush(w.code);
+        execute(w.immediate && w.code.size() == 1 ? m_mode : TapeVM::InputMode::Executing);
+        break;
+      
+      case TapeVM::InputMode::Compiling:
+        if (w.immediate) {
+          xpush(w.code);
+          execute(w.code.size() == 1 ? m_mode : TapeVM::InputMode::Executing);
+        }
+        else {
+          if (w.code.size() > 2)
+            compileReference(getLastDefinition(), word);
+
+          else 
+            compileInline(getLastDefinition(), w.code[0].func, w.code[0].data);
+        }
+        break;
     }
-    else if (isInteger(word)) {
-      switch (getInputMode()) {
-        case TapeVM::InputMode::Interpreting:
-          push(toInteger(word));
-          break;
-        
-        case TapeVM::InputMode::Compiling:
-          compileInline(getLastDefinition(), findWord("(LIT)")->code[0].func, toInteger(word));
-          break;
-      }
-      return;
+  }
+
+
+  void TapeVM::processInteger(std::uintptr_t number) {
+    switch (getInputMode()) {
+      case TapeVM::InputMode::Interpreting:
+        push(number);
+        break;
+      
+      case TapeVM::InputMode::Compiling:
+        compileInline(getLastDefinition(), findWord("(LIT)")->code[0].func, number);
+        break;
     }
-    else if (isRealnum(word)) {
-      switch (getInputMode()) {
-        case TapeVM::InputMode::Interpreting:
-          fpush(toRealnum(word));
-          break;
+  }
+
+
+  void TapeVM::processRealnum(float number) {
+    switch (getInputMode()) {
+      case TapeVM::InputMode::Interpreting:
+        fpush(number);
+        break;
+      
+      case TapeVM::InputMode::Compiling:
+      {
+        auto* d = findWord(getLastDefinition());
+        auto  p = alloc(sizeof(float));
         
-        case TapeVM::InputMode::Compiling:
-        {
-          auto* d = findWord(getLastDefinition());
-          auto  p = alloc(sizeof(float));
-          
-          compileInline(getLastDefinition(), findWord("(FLIT)")->code[0].func, p);
-          findMem(p)->pinned = true;
+        compileInline(getLastDefinition(), findWord("(FLIT)")->code[0].func, p);
+        findMem(p)->pinned = true;
 
-          auto* f = (float*)(d->code.back().data);
-          *f      = toRealnum(word);
-        }  break;
-      }
-      return;
+        auto* f = (float*)(d->code.back().data);
+        *f      = number;
+      }  break;
     }
-    
-    throw TapeError("Unknown Word", word);
   }
 
+  void TapeVM::evaluate(const std::string& source) {
+    auto depth = m_input.depth();
+
+    m_input.push(new StringInputSource(source));
+    auto floor = m_input.setFloor(depth);
+
+    try {
+      for (auto token = getNext(); !token.empty(); token = getNext())
+        processToken(token);
+    }
+    catch (...) {
+      while (m_input.depth() > depth)
+        m_input.pop();
+
+      m_input.setFloor(floor);
+      throw;
+    }
+
+    m_input.setFloor(floor);
+  }
+
+
   void TapeVM::setImmediate(const std::string_view& word) {
     auto* w = findWord(word);
 
@@ -623,6 +820,7 @@ namespace noct {
     m_exec.clear();
     m_cstack.clear();
     m_ostack.clear();
+    m_output.reset();
     resetScratchArena(TapeVM::ScratchReset::ClearStacks);
   }
 
@@ -6,6 +6,7 @@
 #include <NoctSys/Exception/TapeError.hpp>
 
 #include <cassert>
+#include <cctype>
 #include <cmath>
 #include <cstring>
 #include <memory>
@@ -17,6 +18,13 @@ namespace noct {
     loadControlStructures();
     loadVariableDefiners();
     loadParsingWords();
+    loadStdIO();
+    loadMaps();
+    loadRecords();
+    loadMemo();
+    loadMappedFiles();
+    loadTracing();
+    loadNatives();
 
     addWord("words", [=](TapeVM&){
       for (auto word : m_dict) 
@@ -30,18 +38,27 @@ namespace noct {
     /////////////////////////////////
 
     addWord("INCLUDE", [=](TapeVM&){
-      std::string modname = getNext();
+      include(getNext());
+    });
+
+    addWord("RESCAN-INCLUDES", [=](TapeVM&){
+      rescanIncludes();
+    });
+
+    addWord("LAZY-INCLUDES", [=](TapeVM&){
+      if (stackSize())
+        setLazyIncludes(pop());
+
+      else throw TapeError("Stack Underflow", "LAZY-INCLUDES");
+    });
 
-      for (const auto& pathFmt : m_includeDirectories) {
-        std::filesystem::path path(convertDirectory(pathFmt, convertModname(modname)));
+    addWord("(LAZY)", [=](TapeVM&){
+      auto id = getNext();
 
-        if (std::filesystem::exists(path)) {
-          input().push(new FileInputSource(path));
-          return;
-        }
-      } 
+      if (id.empty() || !std::isdigit(id[0]))
+        throw TapeError("Bad Deferred Definition", id);
 
-      throw TapeError("Module Not Found", modname);
+      reachDeferred(std::stoul(id));
     });
   }
 }
\ No newline at end of file
@@ -236,9 +236,9 @@ namespace noct {
         throw TapeError("Return stack underflow", "+LOOP");
 
       auto  inc    = static_cast<std::intptr_t>(pop());
-      auto &index  = rtop(),
-            limit  = rat(rstackSize()),
-            next   = index + inc;
+      auto& index  = rtop();
+      auto  limit  = static_cast<std::intptr_t>(rat(rstackSize() - 2)),
+            next   = static_cast<std::intptr_t>(index) + inc;
       bool  isExit = (inc > 0 && next >= limit) || (inc < 0 && next <= limit);
 
       index = next;
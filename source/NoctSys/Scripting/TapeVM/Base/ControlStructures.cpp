@@ -80,7 +80,7 @@ namespace noct {
       auto  if_frame = cpop();
       
       std::size_t else_ip = w->code.size();
-      w->code[if_frame.patch_ip].data = else_ip - if_frame.patch_ip - 1;
+      w->code[if_frame.patch_ip].data = else_ip - if_frame.patch_ip;
 
       std::size_t jmp_ip = w->code.size();
       compileInline(getLastDefinition(), findWord("(JMP)")->code[0].func, 0ul);
@@ -95,7 +95,7 @@ namespace noct {
         throw TapeError("Compile Only Word", "THEN");
       
       else if (cstack_empty() 
-      or      (ctop().type != TapeVM::ControlFrame::IF && ctop().type) != TapeVM::ControlFrame::ELSE)
+      or      (ctop().type != TapeVM::ControlFrame::IF && ctop().type != TapeVM::ControlFrame::ELSE))
         throw TapeError("THEN without IF or ELSE", "THEN");
 
       auto* w     = findWord(getLastDefinition());
@@ -252,7 +252,7 @@ namespace noct {
 
       auto*       w       = findWord(getLastDefinition());
       std::size_t here_ip = w->code.size();
-      auto        offset  = -static_cast<std::intptr_t>(here_ip - frame.patch_ip + 1);
+      auto        offset  = -static_cast<std::intptr_t>(here_ip - frame.patch_ip);
 
       compileInline(getLastDefinition(), findWord("(LOOP)")->code[0].func, offset);
 
@@ -278,7 +278,7 @@ namespace noct {
 
       auto*       w       = findWord(getLastDefinition());
       std::size_t here_ip = w->code.size();
-      auto        offset  = -static_cast<std::intptr_t>(here_ip - frame.patch_ip + 1);
+      auto        offset  = -static_cast<std::intptr_t>(here_ip - frame.patch_ip);
 
       compileInline(getLastDefinition(), findWord("(+LOOP)")->code[0].func, offset);
 
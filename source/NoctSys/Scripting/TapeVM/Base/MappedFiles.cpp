@@ -0,0 +1,72 @@
+/* TapeVM/Base/MappedFiles.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+namespace noct {
+  // the mapping is registered as a heap block, so findMem and the
+  // checkpoint code see it, but it can only be released by unmapFile
+  std::uintptr_t TapeVM::mapFile(const std::filesystem::path& path, std::size_t& size) {
+    auto file = std::make_unique<MappedFile>();
+
+    if (!file->open(path))
+      throw TapeError("Cannot map file: " + file->getError(), path.string());
+
+    size = file->size();
+
+    if (!size)
+      return 0ul;
+
+    auto   data = reinterpret_cast<std::uintptr_t>(file->data());
+    MemTag tag  { size, data, false, false, true };
+
+    m_mapped[data] = std::move(file);
+    m_regionsDirty = true;
+
+    for (auto& slot : m_mem) {
+      if (slot.free) {
+        slot = tag;
+        return data;
+      }
+    }
+
+    m_mem.push_back(tag);
+    return data;
+  }
+
+
+  void TapeVM::unmapFile(std::uintptr_t data) {
+    auto* tag = findMem(data);
+
+    if (!tag || !tag->mapped)
+      throw TapeError("Not a mapped file", std::to_string(data));
+
+    retire(*tag);
+  }
+
+
+  void TapeVM::loadMappedFiles() {
+    addWord("MAP-FILE", [=](TapeVM&){
+      checkHostPath("MAP-FILE");
+
+      if (hasCells(2)) {
+        auto        len  = static_cast<std::size_t>(pop());
+        auto*       str  = reinterpret_cast<char*>(pop());
+        std::size_t size = 0ul;
+
+        push(mapFile(std::string(str, len), size));
+        push(size);
+      }
+      else throw TapeError("Stack Underflow", "MAP-FILE");
+    });
+
+    addWord("UNMAP-FILE", [=](TapeVM&){
+      if (hasCells(1))
+        unmapFile(pop());
+
+      else throw TapeError("Stack Underflow", "UNMAP-FILE");
+    });
+  }
+}
\ No newline at end of file
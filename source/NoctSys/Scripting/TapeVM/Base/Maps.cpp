@@ -0,0 +1,388 @@
+/* TapeVM/Base/Maps.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace noct {
+  namespace {
+    constexpr std::uint32_t MAP_MAGIC    = 0x4d415021;
+    constexpr std::size_t   MAP_CAPACITY = 16;
+
+    enum SlotState : std::uint32_t {
+      Empty,
+      Deleted,
+      Cell,
+      String
+    };
+
+    struct MapSlot {
+      std::uintptr_t key,
+                     value;
+      std::uint32_t  hash,
+                     state;
+      std::size_t    length;
+    };
+
+    // the header, slots and string keys all live in TapeVM heap blocks, so
+    // maps show up in heap accounting and are covered by checkpoints; the
+    // magic and the header's own address identify a live map. A script can
+    // write all of it, so header() checks the pointers it holds as well
+    struct MapHeader {
+      std::uint32_t  magic;
+      bool           strings;
+      std::uintptr_t self,
+                     slots,
+                     keys;
+      std::size_t    capacity,
+                     count,
+                     used,
+                     keyBytes,
+                     keyCapacity;
+    };
+
+    std::uint32_t hashCell(std::uintptr_t key) {
+      std::uint64_t x = key;
+      x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27; x *= 0x94d049bb133111ebull;
+      x ^= x >> 31;
+      return std::uint32_t(x);
+    }
+
+    std::uint32_t hashString(std::string_view key) {
+      std::uint32_t h = 2166136261u;
+
+      for (auto ch : key) {
+        h ^= std::uint8_t(ch);
+        h *= 16777619u;
+      }
+
+      return h;
+    }
+
+    MapHeader& header(TapeVM& vm, std::uintptr_t map, const char* word, bool write) {
+      auto* hdr = reinterpret_cast<MapHeader*>(map);
+
+      if (!map || map % alignof(MapHeader))
+        throw TapeError("Not a map", word);
+
+      vm.checkAccess(map, sizeof(MapHeader), write, word);
+
+      if (hdr->magic != MAP_MAGIC || hdr->self != map)
+        throw TapeError("Not a map", word);
+
+      if (!hdr->capacity || (hdr->capacity & (hdr->capacity - 1)) || hdr->capacity > SIZE_MAX / sizeof(MapSlot) ||
+          hdr->used >= hdr->capacity || hdr->count > hdr->used || hdr->keyBytes > hdr->keyCapacity ||
+          (!hdr->keys && hdr->keyCapacity))
+        throw TapeError("Corrupt map", word);
+
+      vm.checkBlock(hdr->slots, hdr->capacity * sizeof(MapSlot), word);
+
+      if (hdr->keys)
+        vm.checkBlock(hdr->keys, hdr->keyCapacity, word);
+
+      return *hdr;
+    }
+
+    MapSlot* slots(MapHeader& map) {
+      return reinterpret_cast<MapSlot*>(map.slots);
+    }
+
+    std::string_view keyOf(const MapHeader& map, const MapSlot& slot, const char* word) {
+      if (slot.key > map.keyBytes || slot.length > map.keyBytes - slot.key)
+        throw TapeError("Corrupt map", word);
+
+      return { reinterpret_cast<const char*>(map.keys) + slot.key, slot.length };
+    }
+
+    // finds the slot holding key, or the slot it should be inserted into;
+    // a table with no empty slot left can only have been written by hand
+    MapSlot* probe(MapHeader& map, std::uintptr_t key, std::string_view skey, std::uint32_t hash, bool& found, const char* word) {
+      auto*    table = slots(map);
+      auto     mask  = map.capacity - 1;
+      MapSlot* grave = nullptr;
+
+      for (std::size_t n = 0, i = hash & mask; n < map.capacity; n++, i = (i + 1) & mask) {
+        auto& slot = table[i];
+
+        if (slot.state == Empty) {
+          found = false;
+          return grave ? grave : &slot;
+        }
+
+        if (slot.state == Deleted) {
+          if (!grave)
+            grave = &slot;
+        }
+        else if (slot.hash == hash) {
+          if (map.strings ? keyOf(map, slot, word) == skey : slot.key == key) {
+            found = true;
+            return &slot;
+          }
+        }
+      }
+
+      throw TapeError("Corrupt map", word);
+    }
+
+    std::uintptr_t storeKey(TapeVM& vm, MapHeader& map, std::string_view key) {
+      if (map.keyBytes + key.size() > map.keyCapacity) {
+        auto capacity = std::max(map.keyCapacity * 2, map.keyBytes + key.size());
+
+        map.keys        = map.keys ? vm.realloc(map.keys, capacity) : vm.alloc(capacity);
+        map.keyCapacity = capacity;
+      }
+
+      std::memcpy(reinterpret_cast<char*>(map.keys) + map.keyBytes, key.data(), key.size());
+      vm.touch(map.keys + map.keyBytes, key.size());
+      map.keyBytes += key.size();
+
+      return map.keyBytes - key.size();
+    }
+
+    // rehashes into a fresh table, dropping tombstones and dead key bytes
+    void grow(TapeVM& vm, MapHeader& map, std::size_t capacity, const char* word) {
+      auto* old      = slots(map);
+      auto  oldMap   = map;
+      auto  oldCount = map.capacity;
+      auto  oldKeys  = map.keys;
+
+      map.slots       = vm.alloc(capacity * sizeof(MapSlot));
+      map.capacity    = capacity;
+      map.used        = map.count;
+      map.keys        = 0ul;
+      map.keyBytes    = 0ul;
+      map.keyCapacity = 0ul;
+
+      std::memset(reinterpret_cast<void*>(map.slots), 0, capacity * sizeof(MapSlot));
+
+      for (std::size_t i = 0; i < oldCount; i++) {
+        if (old[i].state < Cell)
+          continue;
+
+        auto slot = old[i];
+
+        if (slot.state == String)
+          slot.key = storeKey(vm, map, keyOf(oldMap, slot, word));
+
+        for (auto j = slot.hash & (capacity - 1);; j = (j + 1) & (capacity - 1)) {
+          if (slots(map)[j].state == Empty) {
+            slots(map)[j] = slot;
+            break;
+          }
+        }
+      }
+
+      vm.freeMem(reinterpret_cast<std::uintptr_t>(old));
+
+      if (oldKeys)
+        vm.freeMem(oldKeys);
+    }
+
+    std::uintptr_t create(TapeVM& vm, bool strings) {
+      auto  map = vm.alloc(sizeof(MapHeader));
+      auto& hdr = *reinterpret_cast<MapHeader*>(map);
+
+      hdr          = { MAP_MAGIC, strings, map, 0ul, 0ul, MAP_CAPACITY, 0ul, 0ul, 0ul, 0ul };
+      hdr.slots    = vm.alloc(MAP_CAPACITY * sizeof(MapSlot));
+
+      std::memset(reinterpret_cast<void*>(hdr.slots), 0, MAP_CAPACITY * sizeof(MapSlot));
+      return map;
+    }
+
+    // pops the key below the map, ( key ) or ( c-addr u ) by map kind
+    std::string_view popKey(TapeVM& vm, MapHeader& map, std::uintptr_t& key, const char* word) {
+      if (!map.strings) {
+        if (!vm.hasCells(1))
+          throw TapeError("Stack Underflow", word);
+
+        key = vm.pop();
+        return {};
+      }
+
+      if (!vm.hasCells(2))
+        throw TapeError("Stack Underflow", word);
+
+      auto length = vm.pop();
+      auto data   = vm.pop();
+
+      vm.checkAccess(data, length, false, word);
+
+      key = 0ul;
+      return { reinterpret_cast<const char*>(data), length };
+    }
+  }
+
+
+  // MAP! MAP@ MAP? MAP-DEL take a cell key, or c-addr u on an SMAP-NEW map;
+  // MAP-EACH ( xt map -- ) calls xt with ( x key ) or ( x c-addr u )
+  void TapeVM::loadMaps() {
+    addWord("MAP-NEW", [=](TapeVM& vm){
+      push(create(vm, false));
+    });
+
+
+    addWord("SMAP-NEW", [=](TapeVM& vm){
+      push(create(vm, true));
+    });
+
+
+    addWord("MAP!", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP!");
+
+      auto           addr = pop();
+      auto&          map  = header(vm, addr, "MAP!", true);
+      std::uintptr_t key;
+      auto           skey = popKey(vm, map, key, "MAP!");
+
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP!");
+
+      auto value = pop();
+      auto hash  = map.strings ? hashString(skey) : hashCell(key);
+      bool found;
+
+      if ((map.used + 1) * 4 > map.capacity * 3)
+        grow(vm, map, map.count * 2 >= map.capacity ? map.capacity * 2 : map.capacity, "MAP!");
+
+      auto* slot = probe(map, key, skey, hash, found, "MAP!");
+
+      if (!found) {
+        if (slot->state == Empty)
+          map.used++;
+
+        map.count++;
+        slot->hash   = hash;
+        slot->length = skey.size();
+        slot->state  = map.strings ? String : Cell;
+        slot->key    = map.strings ? storeKey(vm, map, skey) : key;
+      }
+
+      slot->value = value;
+
+      touch(addr, sizeof(MapHeader));
+      touch(reinterpret_cast<std::uintptr_t>(slot), sizeof(MapSlot));
+    });
+
+
+    addWord("MAP@", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP@");
+
+      auto&          map  = header(vm, pop(), "MAP@", false);
+      std::uintptr_t key;
+      auto           skey = popKey(vm, map, key, "MAP@");
+      bool           found;
+      auto*          slot = probe(map, key, skey, map.strings ? hashString(skey) : hashCell(key), found, "MAP@");
+
+      push(found ? slot->value : 0ul);
+    });
+
+
+    addWord("MAP?", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP?");
+
+      auto&          map  = header(vm, pop(), "MAP?", false);
+      std::uintptr_t key;
+      auto           skey = popKey(vm, map, key, "MAP?");
+      bool           found;
+
+      probe(map, key, skey, map.strings ? hashString(skey) : hashCell(key), found, "MAP?");
+      push(found);
+    });
+
+
+    addWord("MAP-DEL", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP-DEL");
+
+      auto           addr = pop();
+      auto&          map  = header(vm, addr, "MAP-DEL", true);
+      std::uintptr_t key;
+      auto           skey = popKey(vm, map, key, "MAP-DEL");
+      bool           found;
+      auto*          slot = probe(map, key, skey, map.strings ? hashString(skey) : hashCell(key), found, "MAP-DEL");
+
+      if (found) {
+        slot->state = Deleted;
+        map.count--;
+
+        touch(addr, sizeof(MapHeader));
+        touch(reinterpret_cast<std::uintptr_t>(slot), sizeof(MapSlot));
+      }
+    });
+
+
+    addWord("MAP-COUNT", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP-COUNT");
+
+      push(header(vm, pop(), "MAP-COUNT", false).count);
+    });
+
+
+    addWord("MAP-EACH", [=](TapeVM& vm){
+      if (!hasCells(2))
+        throw TapeError("Stack Underflow", "MAP-EACH");
+
+      auto  map = pop();
+      auto  tkn = pop();
+
+      if (m_sandboxed && !isExecutionToken(tkn))
+        throw TapeError("Not an execution token", "MAP-EACH");
+
+      auto* xt  = reinterpret_cast<const WordTag*>(tkn);
+
+      // the callee may store into the map and move its table, so both are
+      // looked up again on every step
+      for (std::size_t i = 0; i < header(vm, map, "MAP-EACH", false).capacity; i++) {
+        auto& hdr  = header(vm, map, "MAP-EACH", false);
+        auto  slot = slots(hdr)[i];
+
+        if (slot.state < Cell)
+          continue;
+
+        push(slot.value);
+
+        if (slot.state == String) {
+          auto skey = keyOf(hdr, slot, "MAP-EACH");
+          auto copy = allot(skey.size());
+
+          std::memcpy(reinterpret_cast<char*>(copy), skey.data(), skey.size());
+          push(copy);
+          push(skey.size());
+        }
+        else push(slot.key);
+
+        call(xt->code);
+      }
+    });
+
+
+    addWord("MAP-FREE", [=](TapeVM& vm){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "MAP-FREE");
+
+      auto  map = pop();
+      auto& hdr = header(vm, map, "MAP-FREE", true);
+
+      freeMem(hdr.slots);
+
+      if (hdr.keys)
+        freeMem(hdr.keys);
+
+      hdr.magic = 0;
+      hdr.self  = 0ul;
+      touch(map, sizeof(MapHeader));
+      freeMem(map);
+    });
+
+  }
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+/* TapeVM/Base/Memo.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+namespace noct {
+  std::vector<TapeVM::MemoStats> TapeVM::memoStats() {
+    std::vector<MemoStats> stats;
+
+    for (const auto& memo : m_memos)
+      stats.push_back({ memo->name, memo->hits, memo->misses, memo->evictions, memo->lru.size() });
+
+    return stats;
+  }
+
+
+  void TapeVM::clearMemos() {
+    for (auto& memo : m_memos) {
+      memo->lru.clear();
+      memo->index.clear();
+    }
+  }
+
+
+  // in out MEMO: name ... ; compiles the body into the hidden word
+  // (memo)name, and name caches its out result cells keyed on the top in
+  // cells, keeping the MEMO_CAPACITY most recently used results
+  void TapeVM::loadMemo() {
+    Function memoized = [=](TapeVM&){
+      auto& token = getExecuting();
+      auto* memo  = reinterpret_cast<MemoTag*>(token.word->at(token.ip).data);
+
+      if (!hasCells(memo->in))
+        throw TapeError("Stack Underflow", memo->name);
+
+      std::vector<std::uintptr_t> key(memo->in);
+
+      for (std::size_t i = 0; i < memo->in; i++)
+        key[i] = at(stackSize() - memo->in + i);
+
+      auto it = memo->index.find(key);
+
+      if (it != memo->index.end()) {
+        memo->hits++;
+        memo->lru.splice(memo->lru.begin(), memo->lru, it->second);
+
+        for (std::size_t i = 0; i < memo->in; i++)
+          pop();
+
+        for (auto cell : it->second->result)
+          push(cell);
+
+        return;
+      }
+
+      memo->misses++;
+
+      auto depth = stackSize() - memo->in;
+      call(*memo->body);
+
+      if (stackSize() != depth + memo->out)
+        throw TapeError("MEMO: arity mismatch", memo->name);
+
+      MemoEntry entry { std::move(key), {} };
+
+      for (std::size_t i = 0; i < memo->out; i++)
+        entry.result.push_back(at(depth + i));
+
+      // a recursive body may already have cached this key
+      if (memo->index.count(entry.key))
+        return;
+
+      memo->lru.push_front(std::move(entry));
+      memo->index[memo->lru.front().key] = memo->lru.begin();
+
+      if (memo->lru.size() > MEMO_CAPACITY) {
+        memo->index.erase(memo->lru.back().key);
+        memo->lru.pop_back();
+        memo->evictions++;
+      }
+    };
+
+    addWord("MEMO:", [=](TapeVM&){
+      if (!hasCells(2))
+        throw TapeError("Stack Underflow", "MEMO:");
+
+      auto name = getNext();
+      auto out  = pop(),
+           in   = pop();
+
+      m_memos.push_back(std::make_unique<MemoTag>());
+
+      auto* memo = m_memos.back().get();
+      memo->name = name;
+      memo->in   = in;
+      memo->out  = out;
+
+      // the body is defined last so that it is the definition being compiled
+      addWord(name, memoized, reinterpret_cast<std::uintptr_t>(memo));
+      addWord("(memo)" + name);
+
+      memo->body = &findWord("(memo)" + name)->code;
+      setInputMode(TapeVM::InputMode::Compiling);
+    });
+
+    setImmediate("MEMO:");
+
+    addWord("MEMO-CLEAR", [=](TapeVM&){
+      clearMemos();
+    });
+
+    addWord(".MEMO", [=](TapeVM&){
+      for (const auto& stats : memoStats()) {
+        output() << stats.name << " hits " << stats.hits << " misses " << stats.misses
+                 << " evictions " << stats.evictions << " entries " << stats.entries << '\n';
+      }
+    });
+  }
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+/* TapeVM/Base/Natives.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Resource/NativeScript.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace noct {
+  namespace {
+    constexpr std::size_t NATIVE_ARITY = 4;
+
+    typedef void (*Trampoline)(TapeVM&, std::uintptr_t);
+
+    // how many arguments after the i'th come off the same stack as it does;
+    // that is the argument's depth below the top of its stack
+    template<typename... A>
+    constexpr std::size_t depth(std::size_t i) {
+      constexpr bool isReal[] = { std::is_same<A, float>::value..., false };
+      std::size_t    n        = 0ul;
+
+      for (auto j = i + 1; j < sizeof...(A); j++)
+        n += isReal[j] == isReal[i];
+
+      return n;
+    }
+
+    template<typename T>
+    T argument(TapeVM& vm, std::size_t depth) {
+      if constexpr (std::is_same<T, float>::value)
+        return vm.fat(vm.fstackSize() - 1 - depth);
+
+      else return static_cast<T>(vm.at(vm.stackSize() - 1 - depth));
+    }
+
+    template<typename R, typename... A, std::size_t... I>
+    void invoke(TapeVM& vm, std::uintptr_t symbol, std::index_sequence<I...>) {
+      constexpr std::size_t reals = (0ul + ... + std::is_same<A, float>::value),
+                            cells = sizeof...(A) - reals;
+
+      if (!vm.hasCells(cells) || !vm.hasFCells(reals))
+        throw TapeError("Stack Underflow", "NATIVE");
+
+      auto             fn   = reinterpret_cast<R(*)(A...)>(symbol);
+      std::tuple<A...> args { argument<A>(vm, depth<A...>(I))... };
+
+      for (auto i = 0ul; i < cells; i++)
+        vm.pop();
+
+      for (auto i = 0ul; i < reals; i++)
+        vm.fpop();
+
+      // a cell may be a heap address the native writes through
+      (..., (std::is_same<A, float>::value ? void() : vm.touch(static_cast<std::uintptr_t>(std::get<I>(args)), 0ul)));
+
+      if constexpr (std::is_void<R>::value)
+        std::apply(fn, args);
+
+      else if constexpr (std::is_same<R, float>::value)
+        vm.fpush(std::apply(fn, args));
+
+      else vm.push(static_cast<std::uintptr_t>(std::apply(fn, args)));
+    }
+
+    // bit i of Mask makes the i'th argument a float, built up last to first
+    template<typename R, unsigned Mask, std::size_t N, typename... A>
+    struct Signature
+      : Signature<R, Mask, N - 1, std::conditional_t<(Mask >> (N - 1)) & 1u, float, std::intptr_t>, A...>
+    {};
+
+    template<typename R, unsigned Mask, typename... A>
+    struct Signature<R, Mask, 0, A...> {
+      static void call(TapeVM& vm, std::uintptr_t symbol) {
+        invoke<R, A...>(vm, symbol, std::index_sequence_for<A...>{});
+      }
+    };
+
+    // every signature of up to NATIVE_ARITY arguments, laid out by arity
+    // then mask: index = 2^arity - 1 + mask
+    constexpr std::size_t arityOf(std::size_t index) {
+      std::size_t n = 0ul;
+
+      while ((2ul << n) - 1 <= index)
+        n++;
+
+      return n;
+    }
+
+    template<typename R, std::size_t... I>
+    constexpr std::array<Trampoline, sizeof...(I)> trampolines(std::index_sequence<I...>) {
+      return {{ &Signature<R, unsigned(I + 1 - (1ul << arityOf(I))), arityOf(I)>::call... }};
+    }
+
+    template<typename R>
+    Trampoline trampoline(std::size_t arity, unsigned mask) {
+      static constexpr auto table = trampolines<R>(std::make_index_sequence<(2ul << NATIVE_ARITY) - 1>{});
+      return table[(1ul << arity) - 1 + mask];
+    }
+  }
+
+
+  void TapeVM::addNativeScript(const std::string& name, const std::shared_ptr<NativeScript>& script) {
+    if (!script || !script->isOpen())
+      throw TapeError("Native Script Not Open", name);
+
+    m_natives[name] = script;
+  }
+
+
+  void TapeVM::loadNatives() {
+    // NATIVE: name script symbol ( n f -- n )
+    //
+    // the symbol is resolved once here and the word calls it through a
+    // trampoline for its signature: n is an intptr_t cell, f a float, with
+    // at most four arguments and one result; natives use C linkage
+    addWord("NATIVE:", [=](TapeVM&){
+      std::string name   = getNext(),
+                  module = getNext(),
+                  symbol = getNext();
+
+      auto script = m_natives.find(module);
+
+      if (script == m_natives.end())
+        throw TapeError("Native Script Not Found", module);
+
+      if (getNext() != "(")
+        throw TapeError("Expected a signature", name);
+
+      std::string semantics = "(";
+      std::size_t arity     = 0ul,
+                  results   = 0ul;
+      unsigned    mask      = 0u;
+      bool        returns   = false,
+                  real      = false;
+
+      for (auto token = getNext(); token != ")"; token = getNext()) {
+        if (token.empty())
+          throw TapeError("Unterminated signature", name);
+
+        semantics += " " + token;
+
+        if (token == "--") {
+          returns = true;
+          continue;
+        }
+
+        if (token != "n" && token != "f")
+          throw TapeError("Signature takes n or f", token);
+
+        if (returns) {
+          real = token == "f";
+          results++;
+        }
+        else {
+          if (token == "f")
+            mask |= 1u << arity;
+
+          arity++;
+        }
+      }
+
+      if (arity > NATIVE_ARITY || results > 1)
+        throw TapeError("Signature too wide", name);
+
+      auto address = reinterpret_cast<std::uintptr_t>(script->second->find(symbol));
+
+      if (!address)
+        throw TapeError("Native Symbol Not Found: " + std::string(script->second->getError()), symbol);
+
+      Trampoline call = !results ? trampoline<void>(arity, mask)
+                      : real     ? trampoline<float>(arity, mask)
+                                 : trampoline<std::intptr_t>(arity, mask);
+
+      addWord(name, [call](TapeVM& vm){
+        auto& token = vm.getExecuting();
+        call(vm, token.word->at(token.ip).data);
+      }, address);
+
+      setSemmantics(name, semantics + " )");
+    });
+  }
+}
\ No newline at end of file
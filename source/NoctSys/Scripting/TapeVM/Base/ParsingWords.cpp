@@ -6,13 +6,14 @@
 #include <NoctSys/Exception/TapeError.hpp>
 
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <cstring>
 
 namespace noct {
   void TapeVM::loadParsingWords() {
     addWord("\\", [=](TapeVM&){
-      for (auto ch = input().get(); ch != '\n'; ch = input().get());
+      for (auto ch = input().get(); ch != '\n' && ch != EOF; ch = input().get());
     });
 
     setImmediate("\\");
@@ -23,13 +24,13 @@ namespace noct {
         {
           auto& word = *findWord(getLastDefinition());
 
-          for (auto ch = input().get(); ch != ')'; ch = input().get())
+          for (auto ch = input().get(); ch != ')' && ch != EOF; ch = input().get())
             word.semantics += ch;
 
           word.semantics += ')';
         } break;
         default:
-          for (auto ch = input().get(); ch != ')'; ch = input().get());
+          for (auto ch = input().get(); ch != ')' && ch != EOF; ch = input().get());
       }
     });
 
@@ -75,7 +76,6 @@ namespace noct {
     addWord("s\"", [=](TapeVM&){
       if (getInputMode() == TapeVM::InputMode::Interpreting) {
         std::string str;
-        char*       cstr = nullptr;
 
         for (auto ch = input().get(); ch != '"'; ch = input().get())
           str += ch;
@@ -96,7 +96,6 @@ namespace noct {
     addWord("c\"", [=](TapeVM&){
       if (getInputMode()== TapeVM::InputMode::Compiling) {
         std::string str;
-        char*       cstr = nullptr;
 
         for (auto ch = input().get(); ch != '"'; ch = input().get())
           str += ch;
@@ -0,0 +1,243 @@
+/* TapeVM/Base/Records.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace noct {
+  // RECORD: name FIELD a FFIELD b n +FIELD c ;RECORD defines name ( -- size )
+  // and, per field, name.a ( addr -- addr' ) with name.a@ and name.a! for
+  // cell and float fields. Offsets are fixed when ;RECORD runs and travel
+  // as word data, so each access is a single primitive.
+  //
+  // n SOA-NEW name allocates one column per field for n records, accessed
+  // with name.a[] ( i soa -- addr ), name.a[]@ and name.a[]!
+  void TapeVM::loadRecords() {
+    auto data = [=]() -> std::uintptr_t {
+      auto& token = getExecuting();
+      return token.word->at(token.ip).data;
+    };
+
+    auto addField = [=](const char* word, std::size_t size, std::size_t align, bool real) {
+      if (!m_openRecord)
+        throw TapeError("Field outside of RECORD:", word);
+
+      auto  name   = getNext();
+      auto& record = *m_openRecord;
+
+      record.size = (record.size + align - 1) / align * align;
+      record.fields.push_back({ name, record.size, size, record.fields.size(), real });
+      record.size += size;
+    };
+
+    // ( i soa -- addr ) for the field carried in the word data
+    auto element = [=](const char* word) -> std::uintptr_t {
+      if (!hasCells(2))
+        throw TapeError("Stack Underflow", word);
+
+      auto* field   = reinterpret_cast<const FieldTag*>(data());
+      auto  soa     = pop();
+      auto  index   = pop();
+
+      checkAccess(soa, (3 + field->column) * sizeof(std::uintptr_t), false, word);
+
+      auto* columns = reinterpret_cast<std::uintptr_t*>(soa);
+
+      if (index >= columns[0])
+        throw TapeError("Index Out Of Range", field->name);
+
+      return columns[2 + field->column] + index * field->size;
+    };
+
+    Function fieldAddress = [=](TapeVM&){
+      if (hasCells(1))
+        top() += data();
+
+      else throw TapeError("Stack Underflow", "FIELD");
+    };
+
+    Function fieldFetch = [=](TapeVM&){
+      if (hasCells(1)) {
+        auto addr = top() + data();
+        checkAccess(addr, sizeof(std::uintptr_t), false, "FIELD@");
+        top() = *reinterpret_cast<std::uintptr_t*>(addr);
+      }
+      else throw TapeError("Stack Underflow", "FIELD@");
+    };
+
+    Function fieldStore = [=](TapeVM&){
+      if (hasCells(2)) {
+        auto addr = pop() + data();
+        checkAccess(addr, sizeof(std::uintptr_t), true, "FIELD!");
+        *reinterpret_cast<std::uintptr_t*>(addr) = pop();
+      }
+      else throw TapeError("Stack Underflow", "FIELD!");
+    };
+
+    Function ffieldFetch = [=](TapeVM&){
+      if (hasCells(1)) {
+        auto addr = pop() + data();
+        checkAccess(addr, sizeof(float), false, "FFIELD@");
+        fpush(*reinterpret_cast<float*>(addr));
+      }
+      else throw TapeError("Stack Underflow", "FFIELD@");
+    };
+
+    Function ffieldStore = [=](TapeVM&){
+      if (hasCells(1) && hasFCells(1)) {
+        auto addr = pop() + data();
+        checkAccess(addr, sizeof(float), true, "FFIELD!");
+        *reinterpret_cast<float*>(addr) = fpop();
+      }
+      else throw TapeError("Stack Underflow", "FFIELD!");
+    };
+
+    Function columnAddress = [=](TapeVM&){
+      push(element("FIELD[]"));
+    };
+
+    Function columnFetch = [=](TapeVM&){
+      auto* field = reinterpret_cast<const FieldTag*>(data());
+      auto  addr  = element("FIELD[]@");
+
+      checkAccess(addr, field->size, false, "FIELD[]@");
+
+      if (field->real)
+        fpush(*reinterpret_cast<float*>(addr));
+
+      else push(*reinterpret_cast<std::uintptr_t*>(addr));
+    };
+
+    Function columnStore = [=](TapeVM&){
+      auto* field = reinterpret_cast<const FieldTag*>(data());
+      auto  addr  = element("FIELD[]!");
+
+      checkAccess(addr, field->size, true, "FIELD[]!");
+
+      if (field->real) {
+        if (!hasFCells(1))
+          throw TapeError("Stack Underflow", "FIELD[]!");
+
+        *reinterpret_cast<float*>(addr) = fpop();
+      }
+      else if (hasCells(1))
+        *reinterpret_cast<std::uintptr_t*>(addr) = pop();
+
+      else throw TapeError("Stack Underflow", "FIELD[]!");
+    };
+
+    addWord("RECORD:", [=](TapeVM&){
+      if (m_openRecord)
+        throw TapeError("Unclosed RECORD:", m_openRecord->name);
+
+      m_records.push_back(std::make_unique<RecordTag>());
+      m_openRecord       = m_records.back().get();
+      m_openRecord->name = getNext();
+    });
+
+    addWord("FIELD", [=](TapeVM&){
+      addField("FIELD", sizeof(std::uintptr_t), alignof(std::uintptr_t), false);
+    });
+
+    addWord("FFIELD", [=](TapeVM&){
+      addField("FFIELD", sizeof(float), alignof(float), true);
+    });
+
+    addWord("+FIELD", [=](TapeVM&){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "+FIELD");
+
+      addField("+FIELD", pop(), 1ul, false);
+    });
+
+    addWord(";RECORD", [=](TapeVM&){
+      if (!m_openRecord)
+        throw TapeError("RECORD: not open", ";RECORD");
+
+      auto& record = *m_openRecord;
+      auto  cell   = alignof(std::uintptr_t);
+
+      record.size  = (record.size + cell - 1) / cell * cell;
+      m_openRecord = nullptr;
+
+      addWord(record.name, findWord("(LIT)")->code[0].func, record.size);
+
+      for (const auto& field : record.fields) {
+        auto prefix = record.name + "." + field.name;
+        auto tag    = reinterpret_cast<std::uintptr_t>(&field);
+
+        addWord(prefix, fieldAddress, field.offset);
+        addWord(prefix + "[]", columnAddress, tag);
+
+        if (field.real) {
+          addWord(prefix + "@", ffieldFetch, field.offset);
+          addWord(prefix + "!", ffieldStore, field.offset);
+        }
+        else if (field.size == sizeof(std::uintptr_t)) {
+          addWord(prefix + "@", fieldFetch, field.offset);
+          addWord(prefix + "!", fieldStore, field.offset);
+        }
+        else continue;
+
+        addWord(prefix + "[]@", columnFetch, tag);
+        addWord(prefix + "[]!", columnStore, tag);
+      }
+    });
+
+    addWord("SOA-NEW", [=](TapeVM&){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "SOA-NEW");
+
+      auto name   = getNext();
+      auto record = std::find_if(m_records.rbegin(), m_records.rend(), [&](const auto& r){
+        return r.get() != m_openRecord && r->name == name;
+      });
+
+      if (record == m_records.rend())
+        throw TapeError("Unknown Record", name);
+
+      auto  count   = pop();
+      auto& fields  = (*record)->fields;
+      auto  soa     = alloc((2 + fields.size()) * sizeof(std::uintptr_t));
+      auto* columns = reinterpret_cast<std::uintptr_t*>(soa);
+
+      columns[0] = count;
+      columns[1] = fields.size();
+
+      for (const auto& field : fields) {
+        columns[2 + field.column] = alloc(count * field.size);
+        std::memset(reinterpret_cast<void*>(columns[2 + field.column]), 0, count * field.size);
+      }
+
+      push(soa);
+    });
+
+    addWord("SOA-FREE", [=](TapeVM&){
+      if (!hasCells(1))
+        throw TapeError("Stack Underflow", "SOA-FREE");
+
+      auto  soa     = pop();
+      auto* columns = reinterpret_cast<std::uintptr_t*>(soa);
+
+      if (!findMem(soa))
+        throw TapeError("Not a valid adress", std::to_string(soa));
+
+      checkAccess(soa, 2 * sizeof(std::uintptr_t), false, "SOA-FREE");
+
+      if (columns[1] > SIZE_MAX / sizeof(std::uintptr_t) - 2)
+        throw TapeError("Not a valid adress", std::to_string(soa));
+
+      checkAccess(soa, (2 + columns[1]) * sizeof(std::uintptr_t), false, "SOA-FREE");
+
+      for (std::size_t i = 0; i < columns[1]; i++)
+        freeMem(columns[2 + i]);
+
+      freeMem(soa);
+    });
+  }
+}
\ No newline at end of file
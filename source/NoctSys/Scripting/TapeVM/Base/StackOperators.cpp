@@ -13,7 +13,7 @@
 namespace noct {
   void TapeVM::loadStackOperators() {
     addWord("+", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a+b);
@@ -22,7 +22,7 @@ namespace noct {
     });
 
     addWord("-", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(b-a);
@@ -31,7 +31,7 @@ namespace noct {
     });
 
     addWord("/", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(b/a);
@@ -40,7 +40,7 @@ namespace noct {
     });
 
     addWord("*", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a*b);
@@ -50,7 +50,7 @@ namespace noct {
     });
 
     addWord("%", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(b%a);
@@ -60,35 +60,35 @@ namespace noct {
     });
 
     addWord("swap", [=](TapeVM&){
-      if (stackSize() >= 2)
+      if (guardedCells(2))
         std::swap(top(), at(stackSize()-2));
         
       else throw TapeError("Stack Underflow", "swap");
     });
 
     addWord("dup", [=](TapeVM&){
-      if (stackSize())
+      if (guardedCells(1))
         push(top());
         
       else throw TapeError("Stack Underflow", "dup");
     });
 
     addWord("drop", [=](TapeVM&){
-      if (stackSize())
+      if (guardedCells(1))
         pop();
         
       else throw TapeError("Stack Underflow", "drop");
     });
 
     addWord("over", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         push(at(stackSize()-2));
       }
       else throw TapeError("Stack Underflow", "over");
     });
 
     addWord("rot", [=](TapeVM&){
-      if (stackSize() >= 3) {
+      if (guardedCells(3)) {
         auto a = top();
         auto b = stackSize() - 2,
              c = stackSize() - 3;
@@ -101,7 +101,7 @@ namespace noct {
     });
 
     addWord("=", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a == b);
@@ -109,39 +109,39 @@ namespace noct {
     });
 
     addWord("<", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
-        push(a<b);
+        push(b<a);
       }
     });
 
     addWord(">", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
-        push(a>b);
+        push(b>a);
       }
     });
 
     addWord("<=", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
-        push(a<=b);
+        push(b<=a);
       }
     });
 
     addWord(">=", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
-        push(a>=b);
+        push(b>=a);
       }
     });
 
     addWord("<>", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a<b || a>b);
@@ -149,7 +149,7 @@ namespace noct {
     });
 
     addWord("|", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a|b);
@@ -157,7 +157,7 @@ namespace noct {
     });
 
     addWord("&", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto a = pop(),
              b = pop();
         push(a&b);
@@ -165,14 +165,14 @@ namespace noct {
     });
 
     addWord("i>f", [=](TapeVM&){
-      if (stackSize())
+      if (guardedCells(1))
         fpush((float)pop());
 
       else throw TapeError("Stack Underflow", "i>f");
     });
 
     addWord("f+", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         auto a = fpop(),
              b = fpop();
         fpush(a+b);
@@ -181,7 +181,7 @@ namespace noct {
     });
 
     addWord("f-", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         auto a = fpop(),
              b = fpop();
         fpush(b-a);
@@ -190,7 +190,7 @@ namespace noct {
     });
 
     addWord("f/", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         auto a = fpop(),
              b = fpop();
         fpush(b/a);
@@ -199,7 +199,7 @@ namespace noct {
     });
 
     addWord("f*", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         auto a = fpop(),
              b = fpop();
         fpush(a*b);
@@ -209,7 +209,7 @@ namespace noct {
     });
 
     addWord("f%", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         auto a = fpop(),
              b = fpop();
         fpush(std::fmod(b, a));
@@ -219,35 +219,35 @@ namespace noct {
     });
 
     addWord("fswap", [=](TapeVM&){
-      if (fstackSize() >= 2)
+      if (guardedFCells(2))
         std::swap(ftop(), fat(fstackSize()-2));
         
       else throw TapeError("Stack Underflow", "fswap");
     });
 
     addWord("fdup", [=](TapeVM&){
-      if (stackSize())
+      if (guardedFCells(1))
         fpush(ftop());
         
       else throw TapeError("Stack Underflow", "fdup");
     });
 
     addWord("fdrop", [=](TapeVM&){
-      if (fstackSize())
+      if (guardedFCells(1))
         fpop();
         
       else throw TapeError("Stack Underflow", "fdrop");
     });
 
     addWord("fover", [=](TapeVM&){
-      if (fstackSize() >= 2) {
+      if (guardedFCells(2)) {
         fpush(fat(fstackSize()-2));
       }
       else throw TapeError("Stack Underflow", "fover");
     });
 
     addWord("frot", [=](TapeVM&){
-      if (fstackSize() >= 3) {
+      if (guardedFCells(3)) {
         auto a = ftop();
         auto b = fstackSize() - 2,
              c = fstackSize() - 3;
@@ -260,28 +260,28 @@ namespace noct {
     });
 
     addWord("f>i", [=](TapeVM&){
-      if (fstackSize())
+      if (guardedFCells(1))
         push((std::uintptr_t)fpop());
       
       else throw TapeError("Stack Underflow", "f>i");
     });
 
     addWord(">R", [=](TapeVM&){
-      if (stackSize())
+      if (guardedCells(1))
         rpush(pop());
 
       else throw TapeError("Stack Underflow", ">R");
     });
 
     addWord("R@", [=](TapeVM&){
-      if (rstackSize())
+      if (guardedRCells(1))
         push(rtop());
       
       else throw TapeError("Stack Underflow", "R@");
     });
 
     addWord("R>", [=](TapeVM&){
-      if (rstackSize())
+      if (guardedRCells(1))
         push(rpop());
 
       else throw TapeError("Stack Underflow", "R>");
@@ -49,8 +49,10 @@ namespace noct {
     addWord("type", [=](TapeVM&){
       if (stackSize() >= 2) {
         auto  len  = static_cast<std::size_t>(pop());
-        auto* str  = reinterpret_cast<char*>(pop());
-        output().write(std::string_view(str, len));
+        auto  addr = pop();
+
+        checkAccess(addr, len, false, "type");
+        output().write(std::string_view(reinterpret_cast<char*>(addr), len));
       }
       else throw TapeError("StackUnderflow", "type");
     });
@@ -109,10 +111,12 @@ namespace noct {
 
     addWord(">OUT", [=](TapeVM&){
       if (stackSize() == 2) {
-        std::string path;
-        auto  len = static_cast<std::size_t>(pop());
-        auto* str = reinterpret_cast<char*>(pop());
-        std::string path(str, len);
+        auto  len  = static_cast<std::size_t>(pop());
+        auto  addr = pop();
+
+        checkAccess(addr, len, false, ">OUT");
+
+        std::string path(reinterpret_cast<char*>(addr), len);
         
         if (path == "stderr") {
           pushOutput(std::make_unique<StderrSource>());
@@ -131,6 +135,8 @@ namespace noct {
           throw TapeError("Invalid input descriptor: stdin", ">OUT");
         }
 
+        checkHostPath(">OUT");
+
         auto* fd = std::fopen(path.c_str(), "w");
 
         if (fd)
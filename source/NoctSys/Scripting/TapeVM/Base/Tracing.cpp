@@ -0,0 +1,85 @@
+/* TapeVM/Base/Tracing.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace noct {
+  void TapeVM::dumpTrace(std::ostream& out, bool binary) {
+#if defined(NOCTSYS_TAPE_TRACE)
+    std::map<std::uintptr_t, std::string> names;
+
+    for (const auto& entry : m_dict)
+      names[reinterpret_cast<std::uintptr_t>(&entry.second.code)] = entry.first;
+
+    auto name = [&](std::uintptr_t word) {
+      auto it = names.find(word);
+
+      if (it != names.end())
+        return it->second;
+
+      std::ostringstream anon;
+      anon << "(anon " << std::hex << word << ")";
+      return anon.str();
+    };
+
+    if (binary)
+      m_trace.writeBinary(out, name);
+
+    else m_trace.writeText(out, name);
+#else
+    (void)out;
+    (void)binary;
+#endif
+  }
+
+
+  void TapeVM::clearTrace() {
+#if defined(NOCTSYS_TAPE_TRACE)
+    m_trace.clear();
+#endif
+  }
+
+
+  void TapeVM::setTraceHandler(TapeVM::TraceHandler handler) {
+#if defined(NOCTSYS_TAPE_TRACE)
+    m_traceHandler = std::move(handler);
+#else
+    (void)handler;
+#endif
+  }
+
+
+  void TapeVM::loadTracing() {
+    addWord("TRACE-DUMP", [=](TapeVM&){
+      std::ostringstream text;
+      dumpTrace(text);
+      output().write(text.str());
+    });
+
+    addWord("TRACE-SAVE", [=](TapeVM&){
+      checkHostPath("TRACE-SAVE");
+
+      if (hasCells(2)) {
+        auto          len  = static_cast<std::size_t>(pop());
+        auto*         str  = reinterpret_cast<char*>(pop());
+        std::string   path(str, len);
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+          throw TapeError("Cannot open trace file", path);
+
+        dumpTrace(file, true);
+      }
+      else throw TapeError("Stack Underflow", "TRACE-SAVE");
+    });
+
+    addWord("TRACE-CLEAR", [=](TapeVM&){
+      clearTrace();
+    });
+  }
+}
\ No newline at end of file
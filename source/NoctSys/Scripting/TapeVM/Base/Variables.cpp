@@ -27,7 +27,7 @@ namespace noct {
     });
 
     addWord("ALLOT", [=](TapeVM&){
-      if (stackSize()) {
+      if (hasCells(1)) {
         auto sz = pop();
         auto p  = allot(sz);
         push(p);
@@ -37,14 +37,17 @@ namespace noct {
 
     addWord("ALLOC", [=](TapeVM&){
       if (isAllocating()) {
-        if (stackSize()) {
+        if (hasCells(1)) {
           auto sz = pop();
-          compileInline(getLastDefinition(), findWord("(END)")->code[0].func, alloc(sz));
+          auto p  = alloc(sz);
+
+          compileInline(getLastDefinition(), findWord("(END)")->code[0].func, p);
+          findMem(p)->pinned = true;
           setAllocating(false);
         }
         else throw TapeError("Stack Underflow", "ALLOC");
       }
-      else if (stackSize()) {
+      else if (hasCells(1)) {
         auto sz = pop();
         auto p  = alloc(sz);
         push(p);
@@ -53,7 +56,7 @@ namespace noct {
     });
 
     addWord("free", [=](TapeVM&){
-      if (stackSize()) {
+      if (hasCells(1)) {
         auto p = pop();
 
         if (!findMem(p))
@@ -64,33 +67,79 @@ namespace noct {
     });
 
     addWord("@", [=](TapeVM&){
-      if (stackSize()) {
+      if (guardedCells(1)) {
         auto addr = pop();
+        checkAccess(addr, sizeof(std::uintptr_t), false, "@");
         push(*(std::uintptr_t*)addr);
       }
       else throw TapeError("Stack Underflow", "@");
     });
 
     addWord("!", [=](TapeVM&){
-      if (stackSize() >= 2) {
+      if (guardedCells(2)) {
         auto  a = pop(),
               b = pop();
+        checkAccess(a, sizeof(std::uintptr_t), true, "!");
         auto* c = reinterpret_cast<std::uintptr_t*>(a);
         *c = b;
       }
     });
 
+    addWord("c@", [=](TapeVM&){
+      if (guardedCells(1)) {
+        auto addr = pop();
+        checkAccess(addr, 1ul, false, "c@");
+        push(*reinterpret_cast<std::uint8_t*>(addr));
+      }
+      else throw TapeError("Stack Underflow", "c@");
+    });
+
+    addWord("c!", [=](TapeVM&){
+      if (guardedCells(2)) {
+        auto a = pop(),
+             b = pop();
+        checkAccess(a, 1ul, true, "c!");
+        *reinterpret_cast<std::uint8_t*>(a) = std::uint8_t(b);
+      }
+      else throw TapeError("Stack Underflow", "c!");
+    });
+
+    addWord("MOVE", [=](TapeVM&){
+      if (guardedCells(3)) {
+        auto n   = pop(),
+             dst = pop(),
+             src = pop();
+        checkAccess(src, n, false, "MOVE");
+        checkAccess(dst, n, true, "MOVE");
+        std::memmove(reinterpret_cast<void*>(dst), reinterpret_cast<const void*>(src), n);
+      }
+      else throw TapeError("Stack Underflow", "MOVE");
+    });
+
+    addWord("FILL", [=](TapeVM&){
+      if (guardedCells(3)) {
+        auto ch   = pop(),
+             n    = pop(),
+             addr = pop();
+        checkAccess(addr, n, true, "FILL");
+        std::memset(reinterpret_cast<void*>(addr), int(ch & 0xff), n);
+      }
+      else throw TapeError("Stack Underflow", "FILL");
+    });
+
     addWord("f@", [=](TapeVM&){
-      if (stackSize()) {
+      if (guardedCells(1)) {
         auto addr = pop();
+        checkAccess(addr, sizeof(float), false, "f@");
         fpush(*reinterpret_cast<float*>(addr));
       }
       else throw TapeError("Stack Underflow", "f@");
     });
 
     addWord("f!", [=](TapeVM&){
-      if (stackSize() && fstackSize()) {
+      if (guardedCells(1) && guardedFCells(1)) {
         auto   a = pop();
+        checkAccess(a, sizeof(float), true, "f!");
         float  b = fpop(),
               *c = reinterpret_cast<float*>(a);
         *c = b;
@@ -99,7 +148,7 @@ namespace noct {
     });
 
     addWord("CONSTANT", [=](TapeVM&){
-      if (stackSize()) {
+      if (hasCells(1)) {
         std::string name = getNext();
         auto        data = pop();
         addWord(name, findWord("(LIT)")->code[0].func, data);
@@ -108,7 +157,7 @@ namespace noct {
     });
 
     addWord("SCONSTANT", [=](TapeVM&){
-      if (stackSize()) {
+      if (hasCells(1)) {
         std::string name = getNext();
         auto        size = pop(),
                     data = pop();
@@ -132,7 +181,7 @@ namespace noct {
     });
 
     addWord("FCONSTANT", [=](TapeVM&){
-      if (fstackSize()) {
+      if (hasFCells(1)) {
         std::string name = getNext();
         float* data = (float*)alloc(sizeof(float));
         *data       = fpop();
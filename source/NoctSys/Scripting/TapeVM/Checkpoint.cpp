@@ -0,0 +1,294 @@
+/* TapeVM/Checkpoint.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+
+namespace noct {
+  // pages of a block the base checkpoint also holds are shared with it
+  // unless written since. Against the latest checkpoint that is read off
+  // the pages marked dirty by the stores; an older base is compared
+  TapeVM::Checkpoint TapeVM::checkpoint(const TapeVM::Checkpoint* base) {
+    Checkpoint                  cp;
+    std::vector<std::uintptr_t> held;
+    bool                        latest = base && base->epoch == m_epoch;
+
+    cp.stack   = m_stack;
+    cp.rstack  = m_rstack;
+    cp.fstack  = m_fstack;
+    cp.exec    = m_exec;
+    cp.cstack  = m_cstack;
+    cp.mode    = m_mode;
+    cp.scratch.assign(m_smem.buffer.begin(), m_smem.buffer.begin() + m_smem.dp);
+
+    cp.heap.reserve(m_mem.size());
+
+    for (std::size_t i = 0; i < m_mem.size(); i++) {
+      const auto& tag = m_mem[i];
+      BlockImage  image { tag, {} };
+
+      if (!tag.free && tag.data && !tag.mapped) {
+        const BlockImage*        prev  = nullptr;
+        const std::vector<bool>* dirty = nullptr;
+        auto*                    bytes = reinterpret_cast<const std::uint8_t*>(tag.data);
+
+        if (base && i < base->heap.size()
+        and base->heap[i].tag.data == tag.data
+        and base->heap[i].tag.size == tag.size)
+          prev = &base->heap[i];
+
+        if (prev && latest) {
+          auto it = m_dirty.find(tag.data);
+
+          if (it != m_dirty.end())
+            dirty = &it->second;
+        }
+
+        for (std::size_t offset = 0; offset < tag.size; offset += CHECKPOINT_PAGE_SIZE) {
+          auto length = std::min(CHECKPOINT_PAGE_SIZE, tag.size - offset);
+          auto page   = offset / CHECKPOINT_PAGE_SIZE;
+          bool same   = prev && (latest
+                      ? !dirty || page >= dirty->size() || !(*dirty)[page]
+                      : std::memcmp(prev->pages[page]->data(), bytes + offset, length) == 0);
+
+          if (same)
+            image.pages.push_back(prev->pages[page]);
+
+          else image.pages.push_back(std::make_shared<const std::vector<std::uint8_t>>(bytes + offset, bytes + offset + length));
+        }
+
+        held.push_back(tag.data);
+        m_holds[tag.data]++;
+      }
+
+      cp.heap.push_back(std::move(image));
+    }
+
+    m_dirty.clear();
+    cp.epoch = ++m_epoch;
+
+    cp.lease = std::shared_ptr<void>(nullptr, [this, held](void*){
+      release(held);
+    });
+
+    return cp;
+  }
+
+
+  // blocks live at the checkpoint keep their addresses: any that were freed
+  // or moved since were retired rather than released while it was held.
+  // Pinned blocks allocated since belong to words defined since, which stay
+  // in the dictionary, so they are kept rather than retired. Blocks are
+  // matched by address, not slot, since a kept block only keeps its slot
+  // when the checkpoint has that slot free
+  void TapeVM::restore(const TapeVM::Checkpoint& cp) {
+    bool                                        latest = cp.epoch == m_epoch;
+    std::unordered_set<std::uintptr_t>          current;
+    std::vector<std::pair<std::size_t, MemTag>> kept;
+
+    for (const auto& tag : m_mem) {
+      if (!tag.free && tag.data)
+        current.insert(tag.data);
+    }
+
+    // everything is checked before anything changes, so a checkpoint that
+    // cannot be restored leaves the VM as it was
+    for (const auto& block : cp.heap) {
+      const auto& image   = block.tag;
+      bool        present = current.count(image.data);
+
+      if (image.free || !image.data)
+        continue;
+
+      if (image.mapped) {
+        if (!present)
+          throw TapeError("Checkpoint mapped file was unmapped", std::to_string(image.data));
+      }
+      else if (!present && std::none_of(m_retired.begin(), m_retired.end(), [&](const MemTag& r){ return r.data == image.data; }))
+        throw TapeError("Checkpoint heap block was released", std::to_string(image.data));
+    }
+
+    m_regionsDirty = true;
+
+    m_stack  = cp.stack;
+    m_rstack = cp.rstack;
+    m_fstack = cp.fstack;
+    m_exec   = cp.exec;
+    m_cstack = cp.cstack;
+    m_mode   = cp.mode;
+
+    if (m_smem.buffer.size() < cp.scratch.size())
+      m_smem.buffer.resize(cp.scratch.size());
+
+    std::copy(cp.scratch.begin(), cp.scratch.end(), m_smem.buffer.begin());
+    m_smem.dp = cp.scratch.size();
+
+    std::unordered_set<std::uintptr_t> live;
+
+    for (const auto& block : cp.heap) {
+      if (!block.tag.free && block.tag.data)
+        live.insert(block.tag.data);
+    }
+
+    for (std::size_t i = 0; i < m_mem.size(); i++) {
+      auto& tag = m_mem[i];
+
+      if (tag.free || !tag.data || live.count(tag.data))
+        continue;
+
+      if (tag.pinned && !tag.mapped)
+        kept.push_back({ i, tag });
+
+      else retire(tag);
+    }
+
+    for (const auto& image : cp.heap) {
+      // mappings are read only and are not captured, only checked
+      if (image.tag.free || !image.tag.data || image.tag.mapped)
+        continue;
+
+      if (!current.count(image.tag.data)) {
+        m_retired.erase(std::find_if(m_retired.begin(), m_retired.end(), [&](const MemTag& r){
+          return r.data == image.tag.data;
+        }));
+      }
+
+      auto* out = reinterpret_cast<std::uint8_t*>(image.tag.data);
+
+      // restoring the latest checkpoint only has to undo the dirty pages;
+      // anything else is compared, and what it changes is dirty after
+      const std::vector<bool>* dirty = nullptr;
+
+      if (latest) {
+        auto it = m_dirty.find(image.tag.data);
+
+        if (it == m_dirty.end())
+          continue;
+
+        dirty = &it->second;
+      }
+
+      for (std::size_t page = 0; page < image.pages.size(); page++) {
+        const auto& bytes = *image.pages[page];
+        auto        dst   = out + page * CHECKPOINT_PAGE_SIZE;
+
+        if (dirty) {
+          if (page < dirty->size() && (*dirty)[page])
+            std::memcpy(dst, bytes.data(), bytes.size());
+        }
+        else if (std::memcmp(dst, bytes.data(), bytes.size()) != 0) {
+          std::memcpy(dst, bytes.data(), bytes.size());
+
+          auto& pages = m_dirty[image.tag.data];
+          pages.resize(image.pages.size(), false);
+          pages[page] = true;
+        }
+      }
+    }
+
+    m_mem.resize(cp.heap.size());
+
+    for (std::size_t i = 0; i < cp.heap.size(); i++)
+      m_mem[i] = cp.heap[i].tag;
+
+    if (latest)
+      m_dirty.clear();
+
+    // a kept block goes back to its own slot when the checkpoint left that
+    // free, so checkpoints taken since still find it where they had it
+    for (auto& entry : kept) {
+      if (entry.first < m_mem.size() && m_mem[entry.first].free) {
+        m_mem[entry.first] = entry.second;
+        entry.second.data  = 0ul;
+      }
+    }
+
+    for (const auto& entry : kept) {
+      if (!entry.second.data)
+        continue;
+
+      auto slot = std::find_if(m_mem.begin(), m_mem.end(), [](const MemTag& t){
+        return t.free;
+      });
+
+      if (slot != m_mem.end())
+        *slot = entry.second;
+
+      else m_mem.push_back(entry.second);
+    }
+  }
+
+
+  void TapeVM::markDirty(std::uintptr_t addr, std::size_t size) {
+    std::uintptr_t begin;
+    std::size_t    length;
+
+    if (m_regionsDirty)
+      indexRegions();
+
+    if (!m_regions.find(addr, begin, length))
+      return;
+
+    auto& pages = m_dirty[begin];
+    auto  count = (length + CHECKPOINT_PAGE_SIZE - 1) / CHECKPOINT_PAGE_SIZE;
+    auto  first = size ? (addr - begin) / CHECKPOINT_PAGE_SIZE : 0ul;
+    auto  last  = size ? std::min(count, (addr - begin + size - 1) / CHECKPOINT_PAGE_SIZE + 1) : count;
+
+    pages.resize(count, false);
+
+    for (auto page = first; page < last; page++)
+      pages[page] = true;
+  }
+
+
+  void TapeVM::retire(TapeVM::MemTag& tag) {
+    m_regionsDirty = true;
+
+    if (tag.mapped)
+      m_mapped.erase(tag.data);
+
+    else if (m_holds.count(tag.data))
+      m_retired.push_back(tag);
+
+    else {
+      m_dirty.erase(tag.data);
+      std::free((char*)(tag.data));
+    }
+
+    tag.data   = 0ul;
+    tag.size   = 0ul;
+    tag.free   = true;
+    tag.mapped = false;
+  }
+
+
+  void TapeVM::release(const std::vector<std::uintptr_t>& blocks) {
+    for (auto data : blocks) {
+      auto hold = m_holds.find(data);
+
+      if (hold == m_holds.end() || --(hold->second))
+        continue;
+
+      m_holds.erase(hold);
+
+      auto it = std::find_if(m_retired.begin(), m_retired.end(), [&](const MemTag& r){
+        return r.data == data;
+      });
+
+      if (it != m_retired.end()) {
+        m_dirty.erase(it->data);
+        std::free((char*)(it->data));
+        m_retired.erase(it);
+      }
+    }
+
+    if (m_holds.empty())
+      m_dirty.clear();
+  }
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+/* TapeVM/GuardedStack.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/GuardedStack.hpp>
+
+#if defined(NOCTSYS_TAPE_GUARDED_STACKS)
+#include <mutex>
+#include <new>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace noct {
+  GuardedRegion::GuardedRegion(std::size_t bytes)
+    : m_base(nullptr), m_length(0ul), m_guard(std::size_t(::sysconf(_SC_PAGESIZE)))
+  {
+    m_length = (bytes + m_guard - 1) / m_guard * m_guard;
+
+    void* map = ::mmap(nullptr, m_length + 2 * m_guard, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (map == MAP_FAILED)
+      throw std::bad_alloc();
+
+    m_base = static_cast<std::uint8_t*>(map) + m_guard;
+
+    if (::mprotect(m_base, m_length, PROT_READ | PROT_WRITE)) {
+      ::munmap(map, m_length + 2 * m_guard);
+      throw std::bad_alloc();
+    }
+  }
+
+
+  GuardedRegion::~GuardedRegion() {
+    ::munmap(m_base - m_guard, m_length + 2 * m_guard);
+  }
+
+
+  void* GuardedRegion::begin() const {
+    return m_base;
+  }
+
+
+  void* GuardedRegion::end() const {
+    return m_base + m_length;
+  }
+
+
+  GuardedRegion::Side GuardedRegion::classify(const void* address) const {
+    auto* p = static_cast<const std::uint8_t*>(address);
+
+    if (p >= m_base - m_guard && p < m_base)
+      return Below;
+
+    if (p >= m_base + m_length && p < m_base + m_length + m_guard)
+      return Above;
+
+    return None;
+  }
+
+
+  namespace guard {
+    static thread_local Scope* s_scope = nullptr;
+    static struct sigaction    s_previous;
+    static std::once_flag      s_installed;
+
+    static void onFault(int sig, siginfo_t* info, void* context) {
+      for (auto* scope = s_scope; scope; scope = scope->prev) {
+        for (auto* region : scope->regions) {
+          auto side = region->classify(info->si_addr);
+
+          if (side != GuardedRegion::None) {
+            scope->side = side;
+            s_scope     = scope->prev;
+            siglongjmp(scope->jump, 1);
+          }
+        }
+      }
+
+      // not one of ours: hand it to whoever was installed before, or let
+      // the fault happen again under the default action
+      if (s_previous.sa_flags & SA_SIGINFO)
+        s_previous.sa_sigaction(sig, info, context);
+
+      else if (s_previous.sa_handler != SIG_IGN && s_previous.sa_handler != SIG_DFL)
+        s_previous.sa_handler(sig);
+
+      else ::signal(sig, SIG_DFL);
+    }
+
+
+    void enter(Scope& scope) {
+      std::call_once(s_installed, []() {
+        struct sigaction action {};
+
+        action.sa_sigaction = onFault;
+        action.sa_flags     = SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+
+        ::sigaction(SIGSEGV, &action, &s_previous);
+      });
+
+      scope.side = GuardedRegion::None;
+      scope.prev = s_scope;
+      s_scope    = &scope;
+    }
+
+
+    void leave(Scope& scope) {
+      if (s_scope == &scope)
+        s_scope = scope.prev;
+    }
+  }
+}
+#endif
\ No newline at end of file
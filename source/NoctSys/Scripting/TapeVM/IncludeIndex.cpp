@@ -0,0 +1,160 @@
+/* TapeVM/IncludeIndex.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/IncludeIndex.hpp>
+
+#if defined(__NoctSys_Linux__)
+  #include <sys/inotify.h>
+  #include <unistd.h>
+  #include <fcntl.h>
+#endif
+
+namespace noct {
+  IncludeIndex::IncludeIndex()
+    : m_mutex(), m_resolved(), m_listings(), m_stats()
+  {
+#if defined(__NoctSys_Linux__)
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+  }
+
+
+  IncludeIndex::~IncludeIndex() {
+#if defined(__NoctSys_Linux__)
+    if (m_inotify >= 0)
+      ::close(m_inotify);
+#endif
+  }
+
+
+  bool IncludeIndex::lookup(const std::string& modname, std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    poll();
+
+    auto it = m_resolved.find(modname);
+
+    if (it == m_resolved.end()) {
+      m_stats.misses++;
+      return false;
+    }
+
+    if (it->second.empty())
+      m_stats.negativeHits++;
+
+    else m_stats.hits++;
+
+    path = it->second;
+    return true;
+  }
+
+
+  bool IncludeIndex::exists(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto directory = path.parent_path().string();
+
+    if (directory.empty())
+      directory = ".";
+
+    auto& listing = list(directory);
+    return listing.exists && listing.entries.count(path.filename().string());
+  }
+
+
+  void IncludeIndex::insert(const std::string& modname, const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_resolved[modname] = path;
+  }
+
+
+  void IncludeIndex::forget() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_resolved.clear();
+  }
+
+
+  void IncludeIndex::rescan() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+#if defined(__NoctSys_Linux__)
+    if (m_inotify >= 0)
+      ::close(m_inotify);
+
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+
+    m_resolved.clear();
+    m_listings.clear();
+    m_stats.invalidations++;
+  }
+
+
+  IncludeIndex::Stats IncludeIndex::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+  }
+
+
+  // any change under a watched directory drops the whole index, so the
+  // next lookups rebuild it from fresh listings
+  void IncludeIndex::poll() {
+#if defined(__NoctSys_Linux__)
+    if (m_inotify < 0 || m_listings.empty())
+      return;
+
+    alignas(inotify_event) char buffer[4096];
+    bool                        changed = false;
+
+    while (::read(m_inotify, buffer, sizeof buffer) > 0)
+      changed = true;
+
+    if (changed) {
+      m_resolved.clear();
+      m_listings.clear();
+      m_stats.invalidations++;
+    }
+#endif
+  }
+
+
+  IncludeIndex::Listing& IncludeIndex::list(const std::string& directory) {
+    auto it = m_listings.find(directory);
+
+    if (it != m_listings.end())
+      return it->second;
+
+    std::error_code ec;
+    Listing         listing { false, {} };
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+      listing.entries.insert(entry.path().filename().string());
+
+    if (!ec)
+      listing.exists = true;
+
+    m_stats.scans++;
+    watch(directory);
+
+    return m_listings[directory] = std::move(listing);
+  }
+
+
+  void IncludeIndex::watch(const std::filesystem::path& directory) {
+#if defined(__NoctSys_Linux__)
+    if (m_inotify < 0)
+      return;
+
+    std::error_code       ec;
+    std::filesystem::path target = directory;
+
+    while (!target.empty() && !std::filesystem::is_directory(target, ec))
+      target = target.parent_path();
+
+    if (target.empty())
+      target = ".";
+
+    inotify_add_watch(m_inotify, target.c_str(),
+      IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+#endif
+  }
+}
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace noct {
   void InputStream::push(InputSource* input) {
-    m_stack.push_back(std::make_unique<InputSource>(input));
+    m_stack.emplace_back(input);
   }
 
   void InputStream::pop() {
@@ -20,7 +20,7 @@ namespace noct {
   }
 
   int InputStream::get() {
-    while (!m_stack.empty()) {
+    while (m_stack.size() > m_floor) {
       int ch = m_stack.back()->get();
 
       if (ch != EOF)
@@ -36,4 +36,16 @@ namespace noct {
     if (!m_stack.empty())
       m_stack.back()->unget();
   }
+
+  std::size_t InputStream::depth() const {
+    return m_stack.size();
+  }
+
+  // sources at or below the floor are never read or exhausted by get(), 
+  // which lets a caller bound reading to the sources it pushed itself
+  std::size_t InputStream::setFloor(std::size_t floor) {
+    std::size_t last = m_floor;
+    m_floor = floor;
+    return last;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+/* TapeVM/ModuleGraph.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/ModuleGraph.hpp>
+#include <NoctSys/Scripting/TapeVM/ModuleScanner.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <thread>
+
+namespace noct {
+  ModuleGraph::ModuleGraph(TapeVM& vm, std::size_t threads)
+    : m_vm(vm), m_threads(threads), m_modules(), m_order(), m_conflicts()
+  {
+    if (!m_threads)
+      m_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+
+  void ModuleGraph::read(const std::vector<std::string>& modnames) {
+    m_modules.clear();
+    m_order.clear();
+    m_conflicts.clear();
+
+    discover(modnames);
+    sort(modnames);
+  }
+
+
+  const ModuleGraph::ModuleMap& ModuleGraph::modules() const {
+    return m_modules;
+  }
+
+
+  const std::vector<std::string>& ModuleGraph::order() const {
+    return m_order;
+  }
+
+
+  const ModuleGraph::ConflictVector& ModuleGraph::conflicts() const {
+    return m_conflicts;
+  }
+
+
+  // modules are resolved, read and scanned a dependency level at a time,
+  // each level spread over the worker threads
+  void ModuleGraph::discover(const std::vector<std::string>& roots) {
+    std::vector<std::string> level;
+
+    for (const auto& modname : roots) {
+      if (std::find(level.begin(), level.end(), modname) == level.end())
+        level.push_back(modname);
+    }
+
+    while (!level.empty()) {
+      std::vector<Module>             found(level.size());
+      std::vector<std::exception_ptr> errors(level.size());
+      std::atomic<std::size_t>        next(0ul);
+      std::vector<std::thread>        workers;
+
+      auto work = [&]() {
+        for (auto i = next++; i < level.size(); i = next++) {
+          try {
+            Module& mod = found[i];
+            mod.modname = level[i];
+            mod.path    = m_vm.findModule(mod.modname);
+
+            if (mod.path.empty())
+              throw TapeError("Module Not Found", mod.modname);
+
+            std::ifstream file(mod.path, std::ios::in | std::ios::binary);
+
+            if (!file.is_open())
+              throw TapeError("Module Not Readable", mod.modname);
+
+            auto source = std::make_shared<std::string>(
+              std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()
+            );
+
+            ModuleScanner scanner(*source);
+
+            for (const auto& inc : scanner.includes()) {
+              mod.includes.push_back(inc.modname);
+              std::fill_n(source->begin() + inc.offset, inc.length, ' ');
+            }
+
+            for (const auto& def : scanner.definitions())
+              mod.definitions.push_back(def.name);
+
+            mod.source = source;
+          }
+          catch (...) {
+            errors[i] = std::current_exception();
+          }
+        }
+      };
+
+      for (auto i = 1ul; i < std::min(m_threads, level.size()); i++)
+        workers.emplace_back(work);
+
+      work();
+
+      for (auto& worker : workers)
+        worker.join();
+
+      for (const auto& error : errors) {
+        if (error)
+          std::rethrow_exception(error);
+      }
+
+      std::vector<std::string> nextLevel;
+
+      for (auto& mod : found) {
+        for (const auto& inc : mod.includes) {
+          if (!m_modules.count(inc)
+          and std::find(level.begin(), level.end(), inc) == level.end()
+          and std::find(nextLevel.begin(), nextLevel.end(), inc) == nextLevel.end())
+            nextLevel.push_back(inc);
+        }
+
+        m_modules[mod.modname] = std::move(mod);
+      }
+
+      level.swap(nextLevel);
+    }
+  }
+
+
+  // depth first post-order over the INCLUDE statements in source order,
+  // which is the order sequential INCLUDE would have compiled them in
+  void ModuleGraph::sort(const std::vector<std::string>& roots) {
+    std::set<std::string> done, active;
+
+    std::function<void(const std::string&)> visit = [&](const std::string& modname) {
+      if (done.count(modname))
+        return;
+
+      if (active.count(modname))
+        throw TapeError("Circular INCLUDE", modname);
+
+      active.insert(modname);
+
+      for (const auto& inc : m_modules.at(modname).includes)
+        visit(inc);
+
+      active.erase(modname);
+      done.insert(modname);
+      m_order.push_back(modname);
+    };
+
+    for (const auto& modname : roots)
+      visit(modname);
+
+    std::map<std::string, std::vector<std::string>> owners;
+
+    for (const auto& modname : m_order) {
+      for (const auto& word : m_modules.at(modname).definitions) {
+        auto& list = owners[word];
+
+        if (list.empty() || list.back() != modname)
+          list.push_back(modname);
+      }
+    }
+
+    for (auto& owner : owners) {
+      if (owner.second.size() > 1)
+        m_conflicts.push_back({ owner.first, owner.second });
+    }
+  }
+
+
+  // in dependency order on the owning VM; the last module to define a
+  // word wins, as it would with sequential INCLUDE
+  void ModuleGraph::compile() {
+    for (const auto& modname : m_order) {
+      const auto& mod = m_modules.at(modname);
+
+      if (m_vm.isLazyIncluding())
+        m_vm.evaluate(m_vm.deferDefinitions(mod.source));
+
+      else m_vm.evaluate(*mod.source);
+    }
+  }
+}
\ No newline at end of file
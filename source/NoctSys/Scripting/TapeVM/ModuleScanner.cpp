@@ -0,0 +1,125 @@
+/* TapeVM/ModuleScanner.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/ModuleScanner.hpp>
+
+#include <cctype>
+
+namespace noct {
+  ModuleScanner::ModuleScanner(std::string_view source)
+    : m_source(source), m_pos(0ul), m_definitions(), m_includes()
+  {
+    scan();
+  }
+
+
+  const ModuleScanner::DefinitionVector& ModuleScanner::definitions() const {
+    return m_definitions;
+  }
+
+
+  const ModuleScanner::IncludeVector& ModuleScanner::includes() const {
+    return m_includes;
+  }
+
+
+  std::string_view ModuleScanner::next() {
+    while (m_pos < m_source.length() && std::isspace(m_source[m_pos]))
+      m_pos++;
+
+    std::size_t start = m_pos;
+
+    while (m_pos < m_source.length() && !std::isspace(m_source[m_pos]))
+      m_pos++;
+
+    return m_source.substr(start, m_pos - start);
+  }
+
+
+  void ModuleScanner::skipUntil(char delim) {
+    while (m_pos < m_source.length() && m_source[m_pos] != delim)
+      m_pos++;
+
+    if (m_pos < m_source.length())
+      m_pos++;
+  }
+
+
+  void ModuleScanner::skipComment() {
+    for (auto word = next(); !word.empty() && word != "*)"; word = next());
+  }
+
+
+  void ModuleScanner::scan() {
+    for (auto word = next(); !word.empty(); word = next()) {
+      std::size_t start = m_pos - word.length();
+
+      if (word == "\\")
+        skipUntil('\n');
+
+      else if (word == "(")
+        skipUntil(')');
+
+      else if (word == "(*" || word == "(**")
+        skipComment();
+
+      else if (word == "s\"" || word == "c\"")
+        skipUntil('"');
+
+      else if (word == "INCLUDE") {
+        auto modname = next();
+
+        if (!modname.empty())
+          m_includes.push_back({ std::string(modname), start, m_pos - start });
+      }
+      else if (word == ":") {
+        Definition def;
+        def.name   = std::string(next());
+        def.offset = start;
+
+        bool closed = false;
+
+        for (auto body = next(); !body.empty(); body = next()) {
+          if (body == ";") {
+            closed = true;
+            break;
+          }
+          else if (body == "\\")
+            skipUntil('\n');
+
+          else if (body == "(")
+            skipUntil(')');
+
+          else if (body == "(*" || body == "(**")
+            skipComment();
+
+          else if (body == "s\"" || body == "c\"")
+            skipUntil('"');
+
+          else {
+            if (body == "[")
+              def.interprets = true;
+
+            def.words.push_back(body);
+          }
+        }
+
+        if (!closed)
+          def.interprets = true;
+
+        std::size_t end  = m_pos;
+        auto        peek = next();
+
+        if (peek == "IMMEDIATE") {
+          def.immediate = true;
+          end           = m_pos;
+        }
+        else m_pos = end;
+
+        def.length = end - start;
+        m_definitions.push_back(std::move(def));
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+/* TapeVM/Modules.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Scripting/TapeVM/ModuleScanner.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <set>
+
+namespace noct {
+  // immediate base words which only affect the definition being compiled,
+  // and so can run as late as the first lookup of that definition
+  static const std::set<std::string_view> s_structureWords = {
+    "IF", "ELSE", "THEN", "BEGIN", "AGAIN", "UNTIL", "WHILE", "REPEAT",
+    "DO", "LOOP", "+LOOP", "LEAVE", "EXIT", "POSTPONE", "[CHAR]", "[']",
+    "c\"", "(LIT)", "(FLIT)", "(JMP)", "(0JMP)", "(BRANCH)", "(END)"
+  };
+
+
+  std::filesystem::path TapeVM::findModule(const std::string& modname) {
+    std::filesystem::path path;
+
+    if (m_includeIndex.lookup(modname, path))
+      return path;
+
+    auto converted = convertModname(modname);
+
+    for (const auto& pathFmt : m_includeDirectories) {
+      std::filesystem::path candidate(convertDirectory(pathFmt, converted));
+
+      if (m_includeIndex.exists(candidate)) {
+        path = candidate;
+        break;
+      }
+    }
+
+    m_includeIndex.insert(modname, path);
+    return path;
+  }
+
+
+  void TapeVM::rescanIncludes() {
+    m_includeIndex.rescan();
+  }
+
+
+  IncludeIndex::Stats TapeVM::includeStats() {
+    return m_includeIndex.stats();
+  }
+
+
+  void TapeVM::include(const std::string& modname) {
+    auto path = findModule(modname);
+
+    if (path.empty())
+      throw TapeError("Module Not Found", modname);
+
+    if (!m_lazyIncludes) {
+      input().push(new FileInputSource(path));
+      return;
+    }
+
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+
+    if (!file.is_open())
+      throw TapeError("Module Not Readable", modname);
+
+    auto source = std::make_shared<const std::string>(
+      std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()
+    );
+
+    input().push(new StringInputSource(deferDefinitions(source)));
+  }
+
+
+  // cuts each plain definition out of the module, leaving a (LAZY) marker
+  // in its place; whether it really goes lazy is decided when the marker
+  // is reached, against the dictionary an eager compile would have seen
+  std::string TapeVM::deferDefinitions(const std::shared_ptr<const std::string>& source) {
+    ModuleScanner                       scanner(*source);
+    std::map<std::string, std::size_t>  counts;
+    std::string                         eager;
+    std::size_t                         pos = 0ul;
+
+    for (const auto& def : scanner.definitions())
+      counts[def.name]++;
+
+    for (const auto& def : scanner.definitions()) {
+      if (def.immediate || def.interprets || counts[def.name] != 1)
+        continue;
+
+      LazyWord word { source, def.offset, def.length, {} };
+
+      for (const auto& use : def.words)
+        if (!s_structureWords.count(use))
+          word.uses.push_back(use);
+
+      auto id = m_deferredId++;
+
+      eager.append(*source, pos, def.offset - pos);
+      eager += "\n(LAZY) " + std::to_string(id) + '\n';
+
+      m_deferred[id] = { def.name, std::move(word) };
+      pos = def.offset + def.length;
+    }
+
+    eager.append(*source, pos, std::string::npos);
+    return eager;
+  }
+
+
+  // a definition stays lazy only if every word it uses already resolves
+  // here, so forward references fail as they would eagerly; otherwise its
+  // source is put back on the input to compile now
+  void TapeVM::reachDeferred(std::size_t id) {
+    auto it = m_deferred.find(id);
+
+    if (it == m_deferred.end())
+      throw TapeError("Bad Deferred Definition", std::to_string(id));
+
+    auto name = std::move(it->second.first);
+    auto word = std::move(it->second.second);
+
+    m_deferred.erase(it);
+
+    bool lazy = !m_dict.count(name) && !m_lazy.count(name);
+
+    for (auto use = word.uses.begin(); lazy && use != word.uses.end(); ++use) {
+      std::string w { *use };
+      auto        found = m_dict.find(w);
+
+      if (found != m_dict.end())
+        lazy = !found->second.immediate;
+
+      else lazy = m_lazy.count(w) || isInteger(w) || isRealnum(w);
+    }
+
+    if (!lazy) {
+      input().push(new StringInputSource(word.source->substr(word.offset, word.length) + '\n'));
+      return;
+    }
+
+    for (const auto& use : word.uses)
+      m_lazyUsers[std::string(use)].insert(name);
+
+    m_lazy[name] = std::move(word);
+  }
+
+
+  // name is about to be redefined in place; lazy words still bound to it,
+  // and a lazy definition of it, compile first so they see the definition
+  // an eager INCLUDE would have given them
+  void TapeVM::settleLazy(const std::string& name) {
+    if (!m_dict.count(name) && !m_lazy.count(name))
+      return;
+
+    auto users = m_lazyUsers.find(name);
+
+    if (users != m_lazyUsers.end()) {
+      auto names = std::move(users->second);
+      m_lazyUsers.erase(users);
+
+      for (const auto& user : names) {
+        auto it = m_lazy.find(user);
+
+        if (it != m_lazy.end())
+          compileLazy(it);
+      }
+    }
+
+    auto it = m_lazy.find(name);
+
+    if (it != m_lazy.end())
+      compileLazy(it);
+  }
+
+
+  void TapeVM::setLazyIncludes(bool flag) {
+    m_lazyIncludes = flag;
+  }
+
+
+  bool TapeVM::isLazyIncluding() {
+    return m_lazyIncludes;
+  }
+
+
+  TapeVM::WordTag* TapeVM::compileLazy(LazyDictionary::iterator it) {
+    auto name = it->first;
+    auto word = it->second;
+
+    m_lazy.erase(it);
+
+    for (const auto& use : word.uses) {
+      auto users = m_lazyUsers.find(std::string(use));
+
+      if (users != m_lazyUsers.end() && users->second.erase(name) && users->second.empty())
+        m_lazyUsers.erase(users);
+    }
+
+    auto         mode  = m_mode;
+    auto         last  = m_lastDefinition;
+    auto         dp    = m_smem.dp;
+    ControlStack cstack;
+    XVector      exec;
+
+    cstack.swap(m_cstack);
+    exec.swap(m_exec);
+    m_mode = TapeVM::InputMode::Interpreting;
+
+    try {
+      evaluate(word.source->substr(word.offset, word.length));
+    }
+    catch (...) {
+      m_cstack.swap(cstack);
+      m_exec.swap(exec);
+      m_mode           = mode;
+      m_lastDefinition = last;
+      m_smem.dp        = dp;
+      throw;
+    }
+
+    m_cstack.swap(cstack);
+    m_exec.swap(exec);
+    m_mode           = mode;
+    m_lastDefinition = last;
+    m_smem.dp        = dp;
+
+    auto found = m_dict.find(name);
+    return found != m_dict.end() ? &(found->second) : nullptr;
+  }
+}
\ No newline at end of file
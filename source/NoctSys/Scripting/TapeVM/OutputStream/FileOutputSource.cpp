@@ -6,11 +6,6 @@
 
 namespace noct {
 
-  FileOutputSource::~FileOutputSource() {
-    if (m_fd) 
-      std::fclose(m_fd);
-  }
-
   void FileOutputSource::write(const char* data, std::size_t size) {
     std::fwrite(data, 1, size, m_fd);
   }
@@ -0,0 +1,80 @@
+/* TapeVM/RegionIndex.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/RegionIndex.hpp>
+
+#include <algorithm>
+
+namespace noct {
+  RegionIndex::RegionIndex()
+    : m_regions(), m_begins(), m_last(0ul)
+  {}
+
+
+  void RegionIndex::clear() {
+    m_regions.clear();
+    m_begins.clear();
+    m_last = 0ul;
+  }
+
+
+  void RegionIndex::insert(std::uintptr_t begin, std::size_t size, bool writable) {
+    if (size)
+      m_regions.push_back({ begin, begin + size, writable });
+  }
+
+
+  void RegionIndex::sort() {
+    std::sort(m_regions.begin(), m_regions.end(), [](const Region& a, const Region& b) {
+      return a.begin < b.begin;
+    });
+
+    m_begins.clear();
+
+    for (const auto& region : m_regions)
+      m_begins.push_back(region.begin);
+
+    m_last = 0ul;
+  }
+
+
+  std::size_t RegionIndex::size() const {
+    return m_regions.size();
+  }
+
+
+  // the region holding addr, if any
+  bool RegionIndex::find(std::uintptr_t addr, std::uintptr_t& begin, std::size_t& size) {
+    if (!search(addr, 1ul, false))
+      return false;
+
+    begin = m_regions[m_last].begin;
+    size  = m_regions[m_last].end - begin;
+    return true;
+  }
+
+
+  bool RegionIndex::search(std::uintptr_t addr, std::size_t size, bool write) {
+    const auto* base  = m_begins.data();
+    auto        count = m_begins.size();
+
+    if (!count || addr < base[0])
+      return false;
+
+    while (count > 1) {
+      auto half = count / 2;
+      base   = base[half] <= addr ? base + half : base;
+      count -= half;
+    }
+
+    auto        index  = std::size_t(base - m_begins.data());
+    const auto& region = m_regions[index];
+
+    if (addr + size > region.end || addr + size < addr)
+      return false;
+
+    m_last = index;
+    return region.writable || !write;
+  }
+}
\ No newline at end of file
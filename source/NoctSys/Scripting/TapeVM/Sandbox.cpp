@@ -0,0 +1,78 @@
+/* TapeVM/Sandbox.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+namespace noct {
+  void TapeVM::setSandboxed(bool flag) {
+    m_sandboxed = flag;
+  }
+
+
+  bool TapeVM::isSandboxed() {
+    return m_sandboxed;
+  }
+
+
+  bool TapeVM::isAccessibleSlow(std::uintptr_t addr, std::size_t size, bool write) {
+    auto scratch = reinterpret_cast<std::uintptr_t>(m_smem.buffer.data());
+
+    if (addr >= scratch && addr + size <= scratch + m_smem.dp && addr + size >= addr)
+      return true;
+
+    if (m_regionsDirty)
+      indexRegions();
+
+    return m_regions.contains(addr, size, write);
+  }
+
+
+  // rebuilt lazily on the first check after the heap changed, so the
+  // accessors themselves never scan the heap
+  void TapeVM::indexRegions() {
+    m_regions.clear();
+
+    for (const auto& tag : m_mem) {
+      if (!tag.free && tag.data)
+        m_regions.insert(tag.data, tag.size, !tag.mapped);
+    }
+
+    m_regions.sort();
+    m_regionsDirty = false;
+  }
+
+
+  bool TapeVM::isHeapBlock(std::uintptr_t addr, std::size_t size) {
+    std::uintptr_t begin;
+    std::size_t    length;
+
+    if (m_regionsDirty)
+      indexRegions();
+
+    return m_regions.find(addr, begin, length) && begin == addr && length >= size &&
+           m_regions.contains(addr, size, true);
+  }
+
+
+  bool TapeVM::isExecutionToken(std::uintptr_t xt) {
+    for (const auto& entry : m_dict) {
+      if (reinterpret_cast<std::uintptr_t>(&entry.second) == xt)
+        return true;
+    }
+
+    return false;
+  }
+
+
+  void TapeVM::checkHostPath(const char* word) {
+    if (m_sandboxed)
+      throw TapeError("Host paths are not available in a sandbox", word);
+  }
+
+
+  void TapeVM::accessFault(std::uintptr_t addr, const char* word) {
+    throw TapeError("Invalid Address " + std::to_string(addr), word);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+/* TapeVM/TraceRing.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM/TraceRing.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace noct {
+  namespace {
+    template<typename T>
+    void put(std::ostream& out, T value) {
+      out.write(reinterpret_cast<const char*>(&value), sizeof value);
+    }
+  }
+
+
+  TraceRing::TraceRing()
+    : m_events(TAPE_TRACE_EVENTS), m_count(0ul)
+  {}
+
+
+  // oldest first
+  std::vector<TraceEvent> TraceRing::events() const {
+    std::vector<TraceEvent> out;
+    auto                    size = std::min<std::uint64_t>(m_count, TAPE_TRACE_EVENTS);
+
+    out.reserve(size);
+
+    for (auto i = m_count - size; i < m_count; i++)
+      out.push_back(m_events[i & (TAPE_TRACE_EVENTS - 1)]);
+
+    return out;
+  }
+
+
+  std::uint64_t TraceRing::recorded() const {
+    return m_count;
+  }
+
+
+  void TraceRing::clear() {
+    m_count = 0ul;
+  }
+
+
+  // one line per event, times in nanoseconds relative to the oldest event
+  void TraceRing::writeText(std::ostream& out, const Namer& name) const {
+    using Ticks = std::chrono::steady_clock::duration;
+
+    auto list = events();
+
+    out << "trace: " << list.size() << " of " << m_count << " events\n";
+
+    if (list.empty())
+      return;
+
+    auto start = list.front().time;
+
+    for (const auto& event : list) {
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Ticks(event.time - start)).count();
+
+      out << "+" << ns << "ns  " << name(event.word)
+          << "  ip " << event.ip << "  depth " << event.depth << "\n";
+    }
+  }
+
+
+  // native endian: "NTRC", u32 version, u64 clock num/den, u64 recorded,
+  // u32 event count, u32 name count, then the events as
+  // { u64 word, u32 ip, u32 depth, u64 time } and the names as
+  // { u64 word, u32 length, bytes }
+  void TraceRing::writeBinary(std::ostream& out, const Namer& name) const {
+    using Period = std::chrono::steady_clock::period;
+
+    auto                                  list = events();
+    std::map<std::uintptr_t, std::string> names;
+
+    for (const auto& event : list) {
+      if (!names.count(event.word))
+        names[event.word] = name(event.word);
+    }
+
+    out.write("NTRC", 4);
+    put<std::uint32_t>(out, 1u);
+    put<std::uint64_t>(out, Period::num);
+    put<std::uint64_t>(out, Period::den);
+    put<std::uint64_t>(out, m_count);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(list.size()));
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(names.size()));
+
+    for (const auto& event : list) {
+      put<std::uint64_t>(out, event.word);
+      put<std::uint32_t>(out, event.ip);
+      put<std::uint32_t>(out, event.depth);
+      put<std::uint64_t>(out, event.time);
+    }
+
+    for (const auto& entry : names) {
+      put<std::uint64_t>(out, entry.first);
+      put<std::uint32_t>(out, static_cast<std::uint32_t>(entry.second.size()));
+      out.write(entry.second.data(), entry.second.size());
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,242 @@
+/* TapeWorker.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeWorker.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <algorithm>
+
+namespace noct {
+  TapeWorker::TapeWorker(const TapeVM::Function& setup)
+    : m_vm(), m_stub(), m_head(&m_stub), m_tail(&m_stub), m_pending(0ul), m_sleeping(false),
+      m_mutex(), m_wake(), m_doneMutex(), m_done(), m_thread()
+  {
+    m_thread = std::thread(&TapeWorker::run, this, setup);
+  }
+
+
+  TapeWorker::~TapeWorker() {
+    auto* job = new Job();
+    job->type = Job::Stop;
+
+    push(job);
+    m_thread.join();
+
+    for (auto* done : m_done)
+      delete done;
+  }
+
+
+  std::future<TapeWorker::Result> TapeWorker::eval(const std::string& source) {
+    auto* job   = new Job();
+    job->type   = Job::Eval;
+    job->text   = source;
+    auto future = job->promise.get_future();
+
+    push(job);
+    return future;
+  }
+
+
+  std::future<TapeWorker::Result> TapeWorker::call(const std::string& word, const std::vector<std::uintptr_t>& args) {
+    auto* job   = new Job();
+    job->type   = Job::Call;
+    job->text   = word;
+    job->args   = args;
+    auto future = job->promise.get_future();
+
+    push(job);
+    return future;
+  }
+
+
+  void TapeWorker::eval(const std::string& source, const TapeWorker::Callback& callback) {
+    auto* job     = new Job();
+    job->type     = Job::Eval;
+    job->text     = source;
+    job->callback = callback;
+
+    push(job);
+  }
+
+
+  void TapeWorker::call(const std::string& word, const std::vector<std::uintptr_t>& args, const TapeWorker::Callback& callback) {
+    auto* job     = new Job();
+    job->type     = Job::Call;
+    job->text     = word;
+    job->args     = args;
+    job->callback = callback;
+
+    push(job);
+  }
+
+
+  // runs the callbacks of every request finished since the last collect,
+  // meant to be called once per frame from the thread that owns the game loop
+  std::size_t TapeWorker::collect() {
+    std::vector<Job*> done;
+
+    {
+      std::lock_guard<std::mutex> lock(m_doneMutex);
+      done.swap(m_done);
+    }
+
+    for (auto* job : done) {
+      job->callback(job->result, job->error);
+      delete job;
+    }
+
+    return done.size();
+  }
+
+
+  std::size_t TapeWorker::pending() const {
+    return m_pending.load();
+  }
+
+
+  // intrusive multi producer single consumer queue (Vyukov); producers only
+  // touch the mutex when the worker has gone to sleep
+  void TapeWorker::push(TapeWorker::Job* job) {
+    if (job != &m_stub)
+      m_pending++;
+
+    job->next.store(nullptr, std::memory_order_relaxed);
+
+    auto* prev = m_head.exchange(job, std::memory_order_acq_rel);
+    prev->next.store(job, std::memory_order_release);
+
+    if (job != &m_stub && m_sleeping.load()) {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_wake.notify_one();
+    }
+  }
+
+
+  TapeWorker::Job* TapeWorker::pop() {
+    auto* tail = m_tail;
+    auto* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &m_stub) {
+      if (!next)
+        return nullptr;
+
+      m_tail = next;
+      tail   = next;
+      next   = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+
+    if (tail != m_head.load(std::memory_order_acquire))
+      return nullptr;
+
+    push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+
+    if (next) {
+      m_tail = next;
+      return tail;
+    }
+
+    return nullptr;
+  }
+
+
+  void TapeWorker::run(const TapeVM::Function& setup) {
+    m_vm.loadTapeBase();
+
+    if (setup)
+      setup(m_vm);
+
+    for (;;) {
+      auto* job = pop();
+
+      if (!job) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleeping = true;
+
+        // pending is counted before a job is linked, so a producer part way
+        // through push keeps the worker spinning rather than asleep
+        m_wake.wait(lock, [this]() { return m_pending.load() > 0; });
+        m_sleeping = false;
+
+        if (!(job = pop())) {
+          lock.unlock();
+          std::this_thread::yield();
+          continue;
+        }
+      }
+
+      m_pending--;
+
+      if (job->type == Job::Stop) {
+        delete job;
+        return;
+      }
+
+      process(*job);
+    }
+  }
+
+
+  void TapeWorker::process(TapeWorker::Job& job) {
+    auto capture = std::make_unique<StringOutputSource>();
+    auto* output = capture.get();
+
+    try {
+      m_vm.pushOutput(std::move(capture));
+
+      if (job.type == Job::Eval)
+        m_vm.evaluate(job.text);
+
+      else {
+        auto* word = m_vm.findWord(job.text);
+
+        if (!word)
+          throw TapeError("Unknown Word", job.text);
+
+        for (auto arg : job.args)
+          m_vm.push(arg);
+
+        m_vm.xpush(word->code);
+        m_vm.execute();
+      }
+
+      job.result.output = output->str();
+    }
+    catch (...) {
+      job.error = std::current_exception();
+    }
+
+    // a failed job's leftovers are drained too, so they never show up in
+    // the next job's result
+    m_vm.popOutput();
+
+    while (m_vm.stackSize())
+      job.result.stack.push_back(m_vm.pop());
+
+    while (m_vm.fstackSize())
+      job.result.fstack.push_back(m_vm.fpop());
+
+    std::reverse(job.result.stack.begin(), job.result.stack.end());
+    std::reverse(job.result.fstack.begin(), job.result.fstack.end());
+
+    if (job.callback) {
+      std::lock_guard<std::mutex> lock(m_doneMutex);
+      m_done.push_back(&job);
+      return;
+    }
+
+    if (job.error)
+      job.promise.set_exception(job.error);
+
+    else job.promise.set_value(std::move(job.result));
+
+    delete &job;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,201 @@
+/* CheckpointTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+int main() {
+  int failed = 0;
+
+  try {
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      auto cp = vm.checkpoint();
+      vm.evaluate("VARIABLE v #5 v !");
+      vm.restore(cp);
+      vm.evaluate("#7 v ! v @");
+
+      failed += check("variables defined after a checkpoint survive restore", vm.stackSize() == 1 && vm.pop() == 7);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      vm.evaluate(": g &2.5 ;");
+
+      auto cp = vm.checkpoint();
+      vm.evaluate(": f &1.5 ;");
+      vm.restore(cp);
+      vm.evaluate("f g");
+
+      failed += check("float literals compiled after a checkpoint survive restore",
+                      vm.fstackSize() == 2 && vm.fpop() == 2.5f && vm.fpop() == 1.5f);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      vm.evaluate("VARIABLE a #1 a !");
+
+      auto first = vm.checkpoint();
+      vm.evaluate("#2 a !");
+      auto second = vm.checkpoint(&first);
+      vm.evaluate("#3 a !");
+      auto third = vm.checkpoint(&second);
+      vm.evaluate("#4 a !");
+
+      vm.restore(third);
+      vm.evaluate("a @");
+      failed += check("restore the latest checkpoint", vm.pop() == 3);
+
+      vm.restore(first);
+      vm.evaluate("a @");
+      failed += check("restore an older checkpoint", vm.pop() == 1);
+
+      auto fourth = vm.checkpoint(&third);
+      vm.evaluate("#5 a !");
+      vm.restore(second);
+      vm.restore(fourth);
+      vm.evaluate("a @");
+      failed += check("incremental checkpoint after a restore", vm.pop() == 1);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      auto  block = vm.alloc(3 * noct::CHECKPOINT_PAGE_SIZE);
+      auto* bytes = reinterpret_cast<std::uint8_t*>(block);
+
+      std::memset(bytes, 0, 3 * noct::CHECKPOINT_PAGE_SIZE);
+
+      auto first = vm.checkpoint();
+      bytes[noct::CHECKPOINT_PAGE_SIZE + 1] = 9;
+      vm.touch(block + noct::CHECKPOINT_PAGE_SIZE + 1, 1ul);
+
+      auto second = vm.checkpoint(&first);
+      failed += check("untouched pages are shared", second.heap.back().pages[0] == first.heap.back().pages[0]
+                                                 && second.heap.back().pages[2] == first.heap.back().pages[2]);
+      failed += check("touched pages are copied", second.heap.back().pages[1] != first.heap.back().pages[1]);
+
+      vm.push(42);
+      vm.push(block + 2 * noct::CHECKPOINT_PAGE_SIZE);
+      vm.evaluate("!");
+      vm.restore(second);
+      failed += check("stores are undone", *reinterpret_cast<std::uintptr_t*>(block + 2 * noct::CHECKPOINT_PAGE_SIZE) == 0
+                                        && bytes[noct::CHECKPOINT_PAGE_SIZE + 1] == 9);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      vm.evaluate("VARIABLE m MAP-NEW m ! #1 #10 m @ MAP!");
+
+      auto cp = vm.checkpoint();
+      vm.evaluate("#2 #10 m @ MAP! #3 #11 m @ MAP!");
+      vm.restore(cp);
+      vm.evaluate("#10 m @ MAP@ m @ MAP-COUNT");
+
+      failed += check("map stores are undone", vm.pop() == 1 && vm.pop() == 1);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      vm.evaluate("VARIABLE m MAP-NEW m ! #1 #10 m @ MAP!");
+
+      auto first = vm.checkpoint();
+      vm.evaluate("#10 m @ MAP@ #10 m @ MAP? m @ MAP-COUNT drop drop drop");
+      auto second = vm.checkpoint(&first);
+      bool shared = first.heap.size() == second.heap.size();
+
+      for (std::size_t i = 0; shared && i < first.heap.size(); i++)
+        shared = first.heap[i].pages == second.heap[i].pages;
+
+      failed += check("map lookups leave every page clean", shared);
+    }
+
+    {
+      auto path = std::filesystem::temp_directory_path() / "noct-checkpoint-test.bin";
+      std::ofstream(path) << "mapped";
+
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      std::size_t size;
+      auto        file = vm.mapFile(path, size);
+
+      vm.evaluate("VARIABLE a #1 a !");
+
+      auto cp = vm.checkpoint();
+      vm.evaluate("#2 a ! #9");
+      vm.unmapFile(file);
+
+      bool threw = false;
+
+      try {
+        vm.restore(cp);
+      }
+      catch (noct::Error&) {
+        threw = true;
+      }
+
+      vm.evaluate("a @");
+      failed += check("a failed restore changes nothing", threw && vm.stackSize() == 2 && vm.pop() == 2 && vm.pop() == 9);
+
+      std::filesystem::remove(path);
+    }
+
+    {
+      noct::TapeVM vm;
+      vm.loadTapeBase();
+
+      auto first = vm.checkpoint();
+      vm.alloc(64);
+
+      auto second = vm.checkpoint();
+      vm.restore(first);
+      vm.evaluate("VARIABLE v #5 v !");
+
+      auto third = vm.checkpoint();
+      vm.restore(second);
+
+      bool restored = true;
+
+      try {
+        vm.restore(third);
+        vm.evaluate("v @");
+      }
+      catch (noct::Error& e) {
+        std::cerr << e.what() << "\n";
+        restored = false;
+      }
+
+      failed += check("a pinned block kept by a restore is found by an older checkpoint", restored && vm.stackSize() == 1 && vm.pop() == 5);
+    }
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: " << e.what() << "\n";
+    failed++;
+  }
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+/* HandleTableTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/HandleTable.hpp>
+#include <NoctSys/Resource/SnapshotTable.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+int main() {
+  int failed = 0;
+
+  {
+    noct::HandleTable<int> table;
+
+    auto handle = table.assign("a", 1);
+    failed += check("a handle resolves to its entry", table.get(handle) && *table.get(handle) == 1);
+    failed += check("resolve gives back the same handle", table.resolve("a") == handle);
+    failed += check("nameOf names the entry", table.nameOf(handle) == "a");
+
+    table.erase("a");
+    failed += check("a handle is stale after erase", !table.get(handle) && !table.use(handle, 1ul));
+    failed += check("a stale handle has no name", table.nameOf(handle).empty());
+    failed += check("an erased name no longer resolves", !table.resolve("a") && !table.find("a"));
+
+    auto reused = table.assign("b", 2);
+    failed += check("an erased slot is reused", reused.index == handle.index);
+    failed += check("a reused slot keeps the old handle stale", !table.get(handle) && reused != handle);
+    failed += check("a reused slot gives its new entry", table.get(reused) && *table.get(reused) == 2);
+
+    auto again = table.assign("b", 3);
+    failed += check("a name keeps its slot when reassigned", again == reused);
+    failed += check("a reassigned name holds its new data", *table.get(reused) == 3 && *table.find("b") == 3);
+  }
+
+  {
+    noct::HandleTable<int> table;
+    std::string            name(64, 'n');
+
+    auto handle = table.assign(name, 7);
+    auto copy   = table;
+
+    table.erase(name);
+
+    for (auto i = 0; i < 64; i++)
+      table.assign(std::string(64, char('a' + i % 26)) + std::to_string(i), i);
+
+    failed += check("a copy still finds a name its source erased", copy.find(name) && *copy.find(name) == 7);
+    failed += check("a copy's handle outlives the source's erase", copy.get(handle) && copy.nameOf(handle) == name);
+    failed += check("a copy lists its own names", copy.names() == std::vector<std::string>{ name });
+  }
+
+  {
+    noct::HandleTable<int> table;
+    table.assign("a", 1);
+
+    auto copy = table;
+    copy.use("a", 42ul);
+    failed += check("a use stamp is shared between copies", table.usage("a") && table.usage("a")->load() == 42ul);
+  }
+
+  {
+    noct::SnapshotTable<noct::HandleTable<int>> view;
+    failed += check("a new snapshot is empty", view.read([](const noct::HandleTable<int>& t){ return !t.find("a"); }));
+
+    noct::HandleTable<int> table;
+    table.assign("a", 1);
+    view.publish(table);
+    failed += check("a published table is read back", view.read([](const noct::HandleTable<int>& t){ return t.find("a") ? *t.find("a") : 0; }) == 1);
+
+    std::atomic<bool>        done { false };
+    std::atomic<int>         bad  { 0 };
+    std::vector<std::thread> readers;
+
+    for (auto i = 0; i < 4; i++) {
+      readers.emplace_back([&]{
+        while (!done) {
+          auto value = view.read([](const noct::HandleTable<int>& t){ return t.find("a") ? *t.find("a") : -1; });
+
+          if (value < 1)
+            bad++;
+        }
+      });
+    }
+
+    for (auto i = 2; i < 2000; i++) {
+      table.assign("a", i);
+      table.assign("x" + std::to_string(i), i);
+      table.erase("x" + std::to_string(i - 1));
+      view.publish(table);
+    }
+
+    done = true;
+
+    for (auto& reader : readers)
+      reader.join();
+
+    failed += check("readers always see a whole snapshot while it is republished", bad == 0);
+    failed += check("the last publish wins", view.read([](const noct::HandleTable<int>& t){ return *t.find("a"); }) == 1999);
+  }
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/* InterpreterTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/Error.hpp>
+#include <NoctSys/Exception/TapeError.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+// evaluates src on a fresh VM and compares the stack, bottom first
+static int expect(const char* what, const char* src, const std::vector<std::uintptr_t>& cells) {
+  std::vector<std::uintptr_t> stack;
+
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+    vm.evaluate(src);
+
+    while (vm.stackSize())
+      stack.insert(stack.begin(), vm.pop());
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: " << what << ": " << e.what() << "\n";
+    return 1;
+  }
+
+  return check(what, stack == cells);
+}
+
+static int rejects(const char* what, const char* src) {
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+    vm.evaluate(src);
+  }
+  catch (noct::Error&) {
+    return 0;
+  }
+
+  return check(what, false);
+}
+
+int main() {
+  int failed = 0;
+
+  failed += expect(": enters compile mode", ": seven #7 ; seven", { 7 });
+  failed += expect("; ends a definition", ": one #1 ; : two one one + ; two", { 2 });
+  failed += expect("interpreting resumes after ;", ": one #1 ; #5 one", { 5, 1 });
+
+  failed += expect("< compares second against top", "#1 #2 < #2 #1 <", { 1, 0 });
+  failed += expect("> compares second against top", "#1 #2 > #2 #1 >", { 0, 1 });
+  failed += expect("<= compares second against top", "#1 #2 <= #2 #1 <= #2 #2 <=", { 1, 0, 1 });
+  failed += expect(">= compares second against top", "#1 #2 >= #2 #1 >= #2 #2 >=", { 0, 1, 1 });
+
+  failed += expect("IF THEN", ": t IF #7 THEN ; #0 t #1 t", { 7 });
+  failed += expect("IF ELSE THEN", ": t IF #1 ELSE #2 THEN #3 ; #1 t #0 t", { 1, 3, 2, 3 });
+  failed += rejects("THEN without IF", ": t BEGIN THEN ;");
+
+  failed += expect("DO LOOP", ": t #0 #5 #0 DO I + LOOP ; t", { 10 });
+  failed += expect("DO +LOOP", ": t #0 #10 #0 DO I + #3 +LOOP ; t", { 18 });
+  failed += expect("DO +LOOP stops at its limit", ": t #4 #0 DO I #2 +LOOP ; t", { 0, 2 });
+
+  failed += expect("\\ at end of input", "#1 \\ no newline", { 1 });
+  failed += expect("( at end of input", "#2 ( unclosed", { 2 });
+
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+    vm.evaluate(">STR #42 . STR>");
+
+    auto  len = vm.pop();
+    auto* str = reinterpret_cast<const char*>(vm.pop());
+    failed += check("loadTapeBase loads the StdIO words", std::string(str, len).find("42") == 0);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: loadTapeBase loads the StdIO words: " << e.what() << "\n";
+    failed++;
+  }
+
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+
+    bool threw = false;
+
+    try {
+      vm.evaluate("drop");
+    }
+    catch (noct::Error&) {
+      threw = true;
+    }
+
+    vm.evaluate("#1 #2 +");
+    failed += check("a failed evaluate leaves the VM interpreting", threw && vm.stackSize() == 1 && vm.pop() == 3);
+
+    vm.evaluate(": t drop ;");
+
+    try {
+      vm.evaluate("t");
+    }
+    catch (noct::Error&) {}
+
+    vm.evaluate(": two #2 ; two");
+    failed += check("a word that throws leaves no frames behind", vm.stackSize() == 1 && vm.pop() == 2);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: recovering after an error: " << e.what() << "\n";
+    failed++;
+  }
+
+#if defined(NOCTSYS_TAPE_TRACE)
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+
+    int handled = 0;
+    vm.setTraceHandler([&](noct::TapeVM&, const noct::TapeError&){ handled++; });
+    vm.addWord("nested", [](noct::TapeVM& vm){
+      vm.xpush(vm.findWord("drop")->code);
+      vm.execute();
+    });
+
+    try {
+      vm.evaluate("nested");
+    }
+    catch (noct::Error&) {}
+
+    failed += check("a nested error reaches the trace handler once", handled == 1);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: trace handler: " << e.what() << "\n";
+    failed++;
+  }
+#endif
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/* LazyIncludeTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+// runs source in a fresh VM with the given lazy setting, returning the top
+// of the stack, or -1 if evaluation threw
+static long run(const std::filesystem::path& dir, bool lazy, const std::string& source) {
+  noct::TapeVM vm;
+  vm.loadTapeBase();
+  vm.addIncludeDirectory((dir / "?.tape").string());
+  vm.setLazyIncludes(lazy);
+
+  try {
+    vm.evaluate(source);
+  }
+  catch (noct::Error&) {
+    return -1;
+  }
+
+  return vm.stackSize() ? long(vm.pop()) : -2;
+}
+
+static int same(const std::filesystem::path& dir, const char* what, const std::string& source, long expect) {
+  long eager = run(dir, false, source),
+       lazy  = run(dir, true, source);
+
+  if (eager != expect || lazy != expect)
+    std::cerr << "  eager " << eager << ", lazy " << lazy << ", expected " << expect << "\n";
+
+  return check(what, eager == expect && lazy == expect);
+}
+
+int main() {
+  auto dir = std::filesystem::temp_directory_path() / "noct-lazy-include-test";
+  std::filesystem::create_directories(dir);
+
+  std::ofstream(dir / "twice.tape")   << ": helper #10 ;\n: twice helper helper + ;\n";
+  std::ofstream(dir / "forward.tape") << ": early later ;\n: later #3 ;\n";
+  std::ofstream(dir / "chain.tape")   << ": one #1 ;\n: two one one + ;\n: four two two + ;\n";
+
+  int failed = 0;
+
+  failed += same(dir, "lazy body binds names visible at INCLUDE",
+                 "INCLUDE twice : helper #1 ; twice", 20);
+  failed += same(dir, "redefinition leaves the new word in place",
+                 "INCLUDE twice : helper #1 ; twice drop helper", 1);
+  failed += same(dir, "forward references are rejected",
+                 "INCLUDE forward #0", -1);
+  failed += same(dir, "lazy words compile through each other",
+                 "INCLUDE chain four", 4);
+  failed += same(dir, "redefining a dependency of a chain",
+                 "INCLUDE chain : one #5 ; four", 4);
+
+  std::filesystem::remove_all(dir);
+  return failed;
+}
\ No newline at end of file
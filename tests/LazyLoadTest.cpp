@@ -0,0 +1,134 @@
+/* LazyLoadTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+// a silent 16 bit mono PCM WAV of samples samples
+static void writeWav(const std::filesystem::path& path, std::uint32_t samples) {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  auto u32 = [&](std::uint32_t v) { for (auto i = 0; i < 4; i++) file.put(char(v >> (8 * i))); };
+  auto u16 = [&](std::uint16_t v) { for (auto i = 0; i < 2; i++) file.put(char(v >> (8 * i))); };
+
+  file.write("RIFF", 4); u32(36 + samples * 2); file.write("WAVE", 4);
+  file.write("fmt ", 4); u32(16); u16(1); u16(1); u32(22050); u32(44100); u16(2); u16(16);
+  file.write("data", 4); u32(samples * 2);
+
+  for (std::uint32_t i = 0; i < samples; i++)
+    u16(0);
+}
+
+int main() {
+  int  failed = 0;
+  auto dir    = std::filesystem::temp_directory_path() / "noct-lazy-test";
+
+  constexpr auto THREADS = 8,
+                 ROUNDS  = 25;
+
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  std::string xml = "<ResourceDatabase version=\"1.1\">\n<SoundDatabase directory=\"" + dir.string() + "\">";
+
+  for (auto name : { "s1", "s2", "s3", "s4" }) {
+    writeWav(dir / (std::string(name) + ".wav"), 1u << 16);
+    xml += std::string("<SoundEntry name=\"") + name + "\" type=\"wav\">" + name + "</SoundEntry>";
+  }
+
+  xml += "</SoundDatabase>\n</ResourceDatabase>\n";
+
+  {
+    std::ofstream file(dir / "db.xml", std::ios::out | std::ios::binary | std::ios::trunc);
+    file << xml;
+  }
+
+  try {
+    bool same = true,
+         all  = true;
+
+    for (auto round = 0; round < ROUNDS; round++) {
+      noct::ResourceDatabase            db(dir / "db.xml", noct::LoadMode::Lazy);
+      std::vector<noct::SoundBufferPtr> found(THREADS);
+      std::vector<std::thread>          threads;
+      std::atomic<bool>                 go { false };
+
+      for (auto i = 0; i < THREADS; i++) {
+        threads.emplace_back([&, i]{
+          while (!go)
+            std::this_thread::yield();
+
+          found[i] = db.findSound("s1");
+        });
+      }
+
+      go = true;
+
+      for (auto& thread : threads)
+        thread.join();
+
+      for (const auto& sound : found) {
+        all  = all && sound;
+        same = same && sound == found[0];
+      }
+
+      all = all && db.findSound("s1") == found[0];
+    }
+
+    failed += check("every thread finding one pending entry gets it", all);
+    failed += check("one pending entry is decoded once for all its finders", same);
+
+    bool gone = true,
+         kept = true;
+
+    for (auto round = 0; round < ROUNDS; round++) {
+      noct::ResourceDatabase db(dir / "db.xml", noct::LoadMode::Lazy);
+      std::atomic<bool>      go { false };
+
+      std::thread batch([&]{
+        while (!go)
+          std::this_thread::yield();
+
+        db.prefetch({ "s1", "s2", "s3", "s4" });
+      });
+
+      // the erase lands at a different point of the batch each round
+      go = true;
+      std::this_thread::sleep_for(std::chrono::microseconds(round * 200));
+
+      db.eraseSound("s2");
+      batch.join();
+
+      gone = gone && !db.findSound("s2");
+      kept = kept && db.findSound("s1") && db.findSound("s3") && db.findSound("s4");
+    }
+
+    failed += check("an entry erased while its batch is in flight stays erased", gone);
+    failed += check("erasing one entry leaves the rest of its batch loaded", kept);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: lazy loading: " << e.what() << "\n";
+    failed++;
+  }
+
+  std::filesystem::remove_all(dir);
+
+  return failed;
+}
\ No newline at end of file
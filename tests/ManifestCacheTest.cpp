@@ -0,0 +1,174 @@
+/* ManifestCacheTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/ManifestCache.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+static void writeFile(const std::filesystem::path& path, const std::string& bytes) {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), bytes.size());
+}
+
+static std::string readFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static bool same(const noct::ResourceManifest& a, const noct::ResourceManifest& b) {
+  if (a.textureDirectory != b.textureDirectory || a.fontDirectory != b.fontDirectory ||
+      a.soundDirectory != b.soundDirectory || a.shaderDirectory != b.shaderDirectory ||
+      a.scriptDirectory != b.scriptDirectory || a.colors != b.colors ||
+      a.entries.size() != b.entries.size())
+    return false;
+
+  for (std::size_t i = 0; i < a.entries.size(); i++) {
+    const auto& x = a.entries[i];
+    const auto& y = b.entries[i];
+
+    if (x.type != y.type || x.name != y.name || x.path != y.path || x.shaderType != y.shaderType ||
+        x.isInline != y.isInline || x.code != y.code)
+      return false;
+  }
+
+  return true;
+}
+
+// rewrites the cache with one edit applied to its bytes
+template<typename Edit>
+static void forge(const std::filesystem::path& path, const std::string& bytes, Edit edit) {
+  auto forged = bytes;
+  edit(forged);
+  writeFile(path, forged);
+}
+
+int main() {
+  int  failed = 0;
+  auto dir    = std::filesystem::temp_directory_path() / "noct-manifest-cache-test";
+
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  auto xmlPath   = dir / "db.xml";
+  auto cachePath = noct::ManifestCache::pathFor(xmlPath);
+  auto xml       = std::string(
+    "<ResourceDatabase version=\"1.1\">\n"
+    "<TextureDatabase directory=\"tex\"><TextureEntry name=\"a\" type=\"png\">a</TextureEntry>"
+    "<TextureEntry name=\"b\" type=\"png\">b</TextureEntry></TextureDatabase>\n"
+    "<ShaderDatabase directory=\"sh\"><ShaderEntry name=\"s\" type=\"frag\">s</ShaderEntry>"
+    "<ShaderEntry name=\"i\" type=\"frag\" inline=\"true\">void main(){}</ShaderEntry></ShaderDatabase>\n"
+    "<ColorDatabase><ColorEntry name=\"red\" hex=\"#ff0000ff\"/></ColorDatabase>\n"
+    "</ResourceDatabase>\n");
+
+  writeFile(xmlPath, xml);
+
+  try {
+    auto parsed = noct::ResourceDatabase::readManifest(xmlPath);
+    auto cached = noct::ResourceDatabase::readCachedManifest(xmlPath);
+
+    failed += check("a cache miss parses the XML", same(parsed, cached));
+    failed += check("a cache miss writes the cache", std::filesystem::exists(cachePath));
+
+    noct::ManifestCache cache;
+    failed += check("a fresh cache opens", cache.open(cachePath, xmlPath));
+    failed += check("a cache hit reproduces readManifest", same(cache.manifest(), parsed));
+    failed += check("the cache keeps every entry", cache.count() == parsed.entries.size() && cache.colorCount() == 1);
+    cache.close();
+
+    failed += check("readCachedManifest reads a hit the same way", same(noct::ResourceDatabase::readCachedManifest(xmlPath), parsed));
+
+    auto bytes = readFile(cachePath);
+    auto mtime = std::filesystem::last_write_time(xmlPath);
+
+    {
+      auto edited = xml;
+      edited.replace(edited.find("name=\"a\""), 8, "name=\"z\"");
+      writeFile(xmlPath, edited);
+      std::filesystem::last_write_time(xmlPath, mtime);
+
+      failed += check("an edit that keeps mtime and size is caught by the hash", !cache.open(cachePath, xmlPath));
+      failed += check("readCachedManifest reparses a changed XML", noct::ResourceDatabase::readCachedManifest(xmlPath).entries[0].name == "z");
+    }
+
+    writeFile(xmlPath, xml);
+    std::filesystem::last_write_time(xmlPath, mtime);
+    writeFile(cachePath, bytes);
+    failed += check("the restored XML matches again", cache.open(cachePath, xmlPath));
+    cache.close();
+
+    writeFile(xmlPath, xml + " ");
+    std::filesystem::last_write_time(xmlPath, mtime);
+    failed += check("a changed size is rejected", !cache.open(cachePath, xmlPath));
+
+    writeFile(xmlPath, xml);
+    std::filesystem::last_write_time(xmlPath, mtime + std::chrono::seconds(2));
+    failed += check("a changed mtime is rejected", !cache.open(cachePath, xmlPath));
+
+    std::filesystem::last_write_time(xmlPath, mtime);
+
+    forge(cachePath, bytes, [](std::string& b){ b.resize(b.size() / 2); });
+    failed += check("a truncated cache is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){
+      noct::ManifestCacheHeader header;
+      std::memcpy(&header, b.data(), sizeof header);
+      header.count += 1000;
+      std::memcpy(&b[0], &header, sizeof header);
+    });
+    failed += check("a record count past the end is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){
+      noct::ManifestCacheHeader header;
+      std::memcpy(&header, b.data(), sizeof header);
+      header.stringsOffset += 8;
+      std::memcpy(&b[0], &header, sizeof header);
+    });
+    failed += check("a moved string table is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){
+      noct::ManifestCacheHeader header;
+      noct::ManifestRecord      record;
+      auto                      at = sizeof header + sizeof(noct::ManifestColor);
+
+      std::memcpy(&header, b.data(), sizeof header);
+      std::memcpy(&record, b.data() + at, sizeof record);
+      record.name.offset = static_cast<std::uint32_t>(header.stringsSize);
+      std::memcpy(&b[at], &record, sizeof record);
+    });
+    failed += check("a string offset past the table is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){
+      noct::ManifestCacheHeader header;
+      std::memcpy(&header, b.data(), sizeof header);
+      header.directories[0].length = static_cast<std::uint32_t>(header.stringsSize) + 1;
+      std::memcpy(&b[0], &header, sizeof header);
+    });
+    failed += check("a directory string past the table is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){ b[0] = 'X'; });
+    failed += check("a bad magic is rejected", !cache.open(cachePath, xmlPath));
+
+    forge(cachePath, bytes, [](std::string& b){ b.resize(b.size() / 2); });
+    failed += check("readCachedManifest falls back on a corrupt cache", same(noct::ResourceDatabase::readCachedManifest(xmlPath), parsed));
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: manifest cache: " << e.what() << "\n";
+    failed++;
+  }
+
+  std::filesystem::remove_all(dir);
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+/* ResourceBudgetTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+// a silent 16 bit mono PCM WAV of samples samples
+static void writeWav(const std::filesystem::path& path, std::uint32_t samples) {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  auto u32 = [&](std::uint32_t v) { for (auto i = 0; i < 4; i++) file.put(char(v >> (8 * i))); };
+  auto u16 = [&](std::uint16_t v) { for (auto i = 0; i < 2; i++) file.put(char(v >> (8 * i))); };
+
+  file.write("RIFF", 4); u32(36 + samples * 2); file.write("WAVE", 4);
+  file.write("fmt ", 4); u32(16); u16(1); u16(1); u32(22050); u32(44100); u16(2); u16(16);
+  file.write("data", 4); u32(samples * 2);
+
+  for (std::uint32_t i = 0; i < samples; i++)
+    u16(0);
+}
+
+int main() {
+  int  failed = 0;
+  auto dir    = std::filesystem::temp_directory_path() / "noct-budget-test";
+
+  constexpr std::uint32_t SAMPLES = 1000;
+  constexpr std::size_t   BYTES   = SAMPLES * sizeof(std::int16_t);
+
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  for (auto name : { "s1", "s2", "s3", "s4" })
+    writeWav(dir / (std::string(name) + ".wav"), SAMPLES);
+
+  try {
+    noct::ResourceDatabase db;
+
+    for (auto name : { "s1", "s2", "s3", "s4" })
+      db.loadSoundFromFile(dir / (std::string(name) + ".wav"));
+
+    failed += check("loaded sounds are counted", db.getUsage(noct::ManifestEntry::Sound) == 4 * BYTES);
+
+    // s1 is held from here on and is the least recently used, so it is the
+    // first one evicted if an outside owner is ever mistaken for an internal one
+    auto held = db.findSound("s1");
+
+    db.trimResources();
+
+    for (auto name : { "s2", "s3", "s4" })
+      db.findSound(name);
+
+    db.setBudget(noct::ManifestEntry::Sound, 2 * BYTES + BYTES / 2);
+    failed += check("entries used this tick are kept", db.getUsage(noct::ManifestEntry::Sound) == 4 * BYTES);
+
+    db.trimResources();
+    failed += check("idle entries over budget are evicted", db.getUsage(noct::ManifestEntry::Sound) == 2 * BYTES);
+    failed += check("an entry held outside is never evicted", db.findSound("s1") == held);
+
+    int evicted = 0;
+
+    for (auto name : { "s2", "s3", "s4" }) {
+      auto before = db.getUsage(noct::ManifestEntry::Sound);
+      auto sound  = db.findSound(name);
+
+      failed += check("an evicted entry reloads on its next find", sound != nullptr);
+
+      if (db.getUsage(noct::ManifestEntry::Sound) > before)
+        evicted++;
+    }
+
+    failed += check("exactly the idle entries over budget were evicted", evicted == 2);
+
+    held.reset();
+
+    for (auto i = 0; i < 2; i++)
+      db.trimResources();
+
+    failed += check("a released entry can be evicted again", db.getUsage(noct::ManifestEntry::Sound) <= 2 * BYTES + BYTES / 2);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: budgets: " << e.what() << "\n";
+    failed++;
+  }
+
+  std::filesystem::remove_all(dir);
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/* ResourcePackTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/ResourcePack.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+static void writeFile(const std::filesystem::path& path, const std::string& bytes) {
+  std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), bytes.size());
+}
+
+static std::string readFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static std::string bytesOf(const noct::ResourcePack& pack, const noct::PackEntry* entry) {
+  if (!entry)
+    return "(missing)";
+  return std::string(reinterpret_cast<const char*>(pack.data(*entry)), entry->size);
+}
+
+int main() {
+  int  failed = 0;
+  auto dir    = std::filesystem::temp_directory_path() / "noct-pack-test";
+
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  std::string texture("\x89PNG\r\n\0 not really a png", 24),
+              font   = "not really a font either",
+              source = "void main() { gl_FragColor = vec4(1.0); }";
+
+  writeFile(dir / "a.png", texture);
+  writeFile(dir / "b.ttf", font);
+
+  auto packPath = dir / "test.npak";
+
+  try {
+    noct::ResourcePackWriter writer;
+
+    noct::ManifestEntry entry;
+    entry.type = noct::ManifestEntry::Texture;
+    entry.name = "a";
+    entry.path = dir / "a.png";
+    writer.add(entry);
+
+    entry.type = noct::ManifestEntry::Font;
+    entry.name = "b";
+    entry.path = dir / "b.ttf";
+    writer.add(entry);
+
+    entry.type     = noct::ManifestEntry::Shader;
+    entry.name     = "i";
+    entry.path.clear();
+    entry.isInline = true;
+    entry.code     = source;
+    writer.add(entry);
+
+    writeFile(packPath, "an older pack");
+
+    std::string error;
+    failed += check("the writer succeeds", writer.write(packPath, error));
+    failed += check("the writer leaves no temporary behind", !std::filesystem::exists(dir / "test.npak.tmp"));
+
+    auto written = readFile(packPath);
+
+    noct::ResourcePack pack;
+    failed += check("a written pack opens", pack.open(packPath));
+    failed += check("the pack counts every entry", pack.count() == 3);
+
+    auto* a = pack.find(noct::ManifestEntry::Texture, "a");
+    auto* b = pack.find(noct::ManifestEntry::Font, "b");
+    auto* i = pack.find(noct::ManifestEntry::Shader, "i");
+
+    failed += check("a file entry keeps its bytes", bytesOf(pack, a) == texture);
+    failed += check("a second file entry keeps its bytes", bytesOf(pack, b) == font);
+    failed += check("an inline entry keeps its source", bytesOf(pack, i) == source);
+    failed += check("an inline entry is flagged", i && (i->flags & noct::PACK_ENTRY_INLINE));
+    failed += check("names round trip", a && pack.name(*a) == "a" && b && pack.name(*b) == "b");
+    failed += check("find keys on the type too", !pack.find(noct::ManifestEntry::Font, "a"));
+    failed += check("blobs are aligned", a && a->offset % noct::RESOURCE_PACK_ALIGNMENT == 0);
+
+    writeFile(dir / "a.png", std::string(texture.size(), 'x'));
+    failed += check("a rewrite succeeds", writer.write(packPath, error));
+    failed += check("a rewrite leaves an open pack's bytes alone", bytesOf(pack, a) == texture);
+
+    noct::ResourcePack rewritten(packPath);
+    failed += check("a rewrite is seen by a new reader", bytesOf(rewritten, rewritten.find(noct::ManifestEntry::Texture, "a")) == std::string(texture.size(), 'x'));
+
+    written = readFile(packPath);
+
+    std::string failing;
+    noct::ResourcePackWriter missing;
+    entry.type     = noct::ManifestEntry::Texture;
+    entry.name     = "gone";
+    entry.path     = dir / "gone.png";
+    entry.isInline = false;
+    missing.add(entry);
+
+    failed += check("a failed write is reported", !missing.write(packPath, failing) && !failing.empty());
+    failed += check("a failed write keeps the old pack", readFile(packPath) == written);
+    failed += check("a failed write removes its temporary", !std::filesystem::exists(dir / "test.npak.tmp"));
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: round trip: " << e.what() << "\n";
+    failed++;
+  }
+
+  auto bytes = readFile(packPath);
+
+  {
+    auto truncated = dir / "truncated.npak";
+    writeFile(truncated, bytes.substr(0, sizeof(noct::PackHeader) + sizeof(noct::PackEntry) / 2));
+
+    noct::ResourcePack pack;
+    failed += check("a truncated index is rejected", !pack.open(truncated) && !pack.isOpen());
+  }
+
+  {
+    auto overrun = dir / "overrun.npak";
+    auto forged  = bytes;
+
+    noct::PackHeader header;
+    std::memcpy(&header, forged.data(), sizeof header);
+
+    for (std::uint32_t i = 0; i < header.buckets; i++) {
+      auto            at = sizeof(noct::PackHeader) + i * sizeof(noct::PackEntry);
+      noct::PackEntry entry;
+      std::memcpy(&entry, forged.data() + at, sizeof entry);
+
+      if (entry.nameLength) {
+        entry.offset = forged.size() - 1;
+        std::memcpy(forged.data() + at, &entry, sizeof entry);
+        break;
+      }
+    }
+
+    writeFile(overrun, forged);
+
+    noct::ResourcePack pack;
+    failed += check("an entry running past the end is rejected", !pack.open(overrun) && !pack.isOpen());
+  }
+
+  std::filesystem::remove_all(dir);
+
+  return failed;
+}
\ No newline at end of file
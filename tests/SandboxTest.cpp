@@ -0,0 +1,84 @@
+/* SandboxTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+// evaluates source in a fresh sandboxed VM; true if it was refused
+static bool refused(const std::string& source) {
+  noct::TapeVM vm;
+  vm.loadTapeBase();
+  vm.setSandboxed(true);
+
+  try {
+    vm.evaluate(source);
+  }
+  catch (noct::Error&) {
+    return true;
+  }
+
+  return false;
+}
+
+// a map header built by hand in a heap block, its slot table at slots
+static std::string forgedMap(std::uintptr_t slots) {
+  auto at = [](int offset) { return " h @ #" + std::to_string(offset) + " + ! "; };
+
+  return "VARIABLE h #72 ALLOC h ! $4D415021 h @ ! h @" + at(8) + "#" + std::to_string(slots) + at(16) +
+         "#0" + at(24) + "#2" + at(32) + "#0" + at(40) + "#0" + at(48) + "#0" + at(56) + "#0" + at(64);
+}
+
+int main() {
+  int failed = 0;
+  std::uintptr_t host[16] = {};
+  auto           hostAddress = reinterpret_cast<std::uintptr_t>(host);
+
+  failed += check("record fields check their address",
+                  refused("RECORD: pt FIELD x ;RECORD #16 pt.x@"));
+  failed += check("record field stores check their address",
+                  refused("RECORD: pt FIELD x ;RECORD #1 #16 pt.x!"));
+  failed += check("record columns check the SOA block",
+                  refused("RECORD: pt FIELD x ;RECORD #0 #16 pt.x[]@"));
+  failed += check("string map keys check their address",
+                  refused("VARIABLE m SMAP-NEW m ! #1 #16 #4 m @ MAP!"));
+  failed += check("type checks its address",
+                  refused("#16 #4 type"));
+  failed += check("MAP-EACH only calls execution tokens",
+                  refused("VARIABLE m MAP-NEW m ! #1 #2 m @ MAP! #16 m @ MAP-EACH"));
+  failed += check("MAP-FILE refuses host paths",
+                  refused("s\" /etc/hostname\" MAP-FILE"));
+  failed += check("TRACE-SAVE refuses host paths",
+                  refused("s\" trace.bin\" TRACE-SAVE"));
+
+  failed += check("MAP! refuses a forged header's slot table",
+                  refused(forgedMap(hostAddress) + "#7 #99 h @ MAP!"));
+  failed += check("MAP@ refuses a forged header's slot table",
+                  refused(forgedMap(hostAddress) + "#99 h @ MAP@"));
+  failed += check("MAP! refuses a slot table smaller than its capacity",
+                  refused(forgedMap(0) + "#8 ALLOC h @ #16 + ! #7 #99 h @ MAP!"));
+  failed += check("forged maps leave host memory alone",
+                  std::all_of(host, host + 16, [](std::uintptr_t cell) { return cell == 0; }));
+  failed += check("SOA-FREE refuses a column count that wraps",
+                  refused("VARIABLE s #16 ALLOC s ! #0 s @ ! $FFFFFFFFFFFFFFFF s @ #8 + ! s @ SOA-FREE"));
+
+  failed += check("records on heap blocks still work",
+                  !refused("RECORD: pt FIELD x ;RECORD pt ALLOC dup #7 swap pt.x! pt.x@ drop"));
+  failed += check("string maps on scratch keys still work",
+                  !refused("VARIABLE m SMAP-NEW m ! #1 s\" key\" m @ MAP! s\" key\" m @ MAP@ drop"));
+  failed += check("cell maps grow and still work",
+                  !refused("VARIABLE m : fill #40 #0 DO I I m @ MAP! LOOP ; MAP-NEW m ! fill #39 m @ MAP@ drop m @ MAP-FREE"));
+
+  return failed;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/* StaticTapeTest.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Scripting/TapeVM.hpp>
+#include <NoctSys/Scripting/TapeVM/StaticTape.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <iostream>
+
+static constexpr auto add  = noct::compileTape("#2 #3 +");
+static constexpr auto def  = noct::compileTape(": seven #7 ;");
+
+static int check(const char* what, bool ok) {
+  if (!ok)
+    std::cerr << "FAIL: " << what << "\n";
+  return ok ? 0 : 1;
+}
+
+int main() {
+  int failed = 0;
+
+  try {
+    noct::TapeVM vm;
+    vm.loadTapeBase();
+
+    vm.addWord("glue", add.bind());
+    vm.evaluate("glue glue");
+    failed += check("bound tape runs through addWord", vm.stackSize() == 2 && vm.pop() == 5 && vm.pop() == 5);
+
+    vm.addWord("defs", def.bind());
+    vm.evaluate("defs seven");
+    failed += check("bound tape defines words", vm.stackSize() == 1 && vm.pop() == 7);
+
+    vm.evaluate(": twice glue glue + ;");
+    vm.evaluate("twice");
+    failed += check("bound tape runs inside a definition", vm.stackSize() == 1 && vm.pop() == 10);
+
+    add(vm);
+    failed += check("tape runs directly", vm.stackSize() == 1 && vm.pop() == 5);
+  }
+  catch (noct::Error& e) {
+    std::cerr << "FAIL: " << e.what() << "\n";
+    failed++;
+  }
+
+  return failed;
+}
\ No newline at end of file
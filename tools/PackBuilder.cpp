@@ -0,0 +1,55 @@
+/* PackBuilder.cpp
+ * Copyright (c) 2020-2025, Christopher Stephen Rafuse
+ * BSD-2-Clause
+ */
+#include <NoctSys/Resource/Database.hpp>
+#include <NoctSys/Resource/ResourcePack.hpp>
+#include <NoctSys/Exception/Error.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+// noct_pack <database.xml> <output.npak>
+//
+// packs every texture, font, sound and shader the database lists; native
+// scripts and colours are left to the XML, which is still loaded for them
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <database.xml> <output.npak>\n";
+    return 2;
+  }
+
+  try {
+    auto                     manifest = noct::ResourceDatabase::readManifest(argv[1]);
+    noct::ResourcePackWriter writer;
+    std::size_t              skipped  = 0ul;
+    std::string              error;
+
+    for (const auto& entry : manifest.entries) {
+      if (entry.type == noct::ManifestEntry::Script)
+        skipped++;
+
+      else writer.add(entry);
+    }
+
+    if (!writer.write(argv[2], error)) {
+      std::cerr << error << "\n";
+      return 1;
+    }
+
+    std::cout << "packed " << writer.count() << " entries, "
+              << std::filesystem::file_size(argv[2]) << " bytes";
+
+    if (skipped)
+      std::cout << ", " << skipped << " native scripts left out";
+
+    std::cout << "\n";
+  }
+  catch (noct::Error& e) {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
\ No newline at end of file